@@ -17,9 +17,15 @@
 
 #include <CLI/CLI.hpp>
 
+#include <algorithm>
 #include <cynthia/core.hpp>
 #include <cynthia/logger.hpp>
+#include <cynthia/logic/serialization.hpp>
 #include <cynthia/parser/driver.hpp>
+#include <cynthia/parser/string_parser.hpp>
+#include <cynthia/spec_stream.hpp>
+#include <fstream>
+#include <map>
 
 int main(int argc, char** argv) {
   cynthia::utils::Logger logger("main");
@@ -33,9 +39,69 @@ int main(int argc, char** argv) {
   app.add_flag("-V,--version", version, "Print the version and exit.");
   bool verbose = false;
   app.add_flag("-v,--verbose", verbose, "Set verbose mode.");
-  bool enable_gc = false;
-  app.add_flag("-g,--garbage-collection", enable_gc,
+  cynthia::core::GcOptions gc_options;
+  app.add_flag("-g,--garbage-collection", gc_options.enabled,
                "Enable garbage collection.");
+  app.add_option("--gc-budget", gc_options.memory_budget,
+                 "With -g, collect the garbage whenever the SDD manager is "
+                 "larger than this size, in SDD elements (in nodes with "
+                 "--backend bdd).");
+  app.add_flag("--gc-safe-points", gc_options.safe_points_only,
+               "With -g, collect the garbage only between two states of the "
+               "search.");
+  cynthia::core::VtreeSearchOptions vtree_search_options;
+  app.add_flag("--vtree-search", vtree_search_options.enabled,
+               "Search for a better variable order during the synthesis. The "
+               "state, environment and system variables are reordered within "
+               "their own group.");
+  app.add_option("--vtree-search-time", vtree_search_options.time_limit,
+                 "Time limit of each vtree search, in seconds.");
+  const std::map<std::string, cynthia::core::VariableOrder> variable_orders{
+      {"closure", cynthia::core::VariableOrder::closure},
+      {"dfs", cynthia::core::VariableOrder::dfs},
+      {"cooccurrence", cynthia::core::VariableOrder::cooccurrence},
+      {"by-atoms", cynthia::core::VariableOrder::by_atoms}};
+  const std::map<std::string, cynthia::core::VtreeShape> vtree_shapes{
+      {"balanced", cynthia::core::VtreeShape::balanced},
+      {"right-linear", cynthia::core::VtreeShape::right_linear}};
+  cynthia::core::VtreeOptions vtree_options;
+  auto vtree_order = cynthia::core::VariableOrder::closure;
+  app.add_option("--vtree-order", vtree_order,
+                 "Order of the variables in each group of the vtree.")
+      ->transform(CLI::CheckedTransformer(variable_orders));
+  auto vtree_shape = cynthia::core::VtreeShape::balanced;
+  app.add_option("--vtree-shape", vtree_shape,
+                 "Shape of the vtree of each group of variables.")
+      ->transform(CLI::CheckedTransformer(vtree_shapes));
+  auto state_order_opt =
+      app.add_option("--state-order", vtree_options.state.order,
+                     "Order of the state variables; overrides --vtree-order.")
+          ->transform(CLI::CheckedTransformer(variable_orders));
+  auto env_order_opt =
+      app.add_option("--env-order", vtree_options.environment.order,
+                     "Order of the environment variables; overrides "
+                     "--vtree-order.")
+          ->transform(CLI::CheckedTransformer(variable_orders));
+  auto system_order_opt =
+      app.add_option("--system-order", vtree_options.system.order,
+                     "Order of the system variables; overrides --vtree-order.")
+          ->transform(CLI::CheckedTransformer(variable_orders));
+  app.add_option("--vtree-cache", vtree_options.cache_directory,
+                 "Directory of the vtree cache. The vtree of a solve, tuned "
+                 "with --vtree-search, is stored there and reused by the "
+                 "next solves of the same specification.");
+  const std::map<std::string, cynthia::core::Backend> backends{
+      {"sdd", cynthia::core::Backend::sdd},
+      {"bdd", cynthia::core::Backend::bdd}};
+  auto backend = cynthia::core::Backend::sdd;
+  app.add_option("--backend", backend,
+                 "Decision diagram of the search. With bdd, the search runs "
+                 "on the in-tree BDD manager, and the vtree options are "
+                 "ignored.")
+      ->transform(CLI::CheckedTransformer(backends));
+  bool no_simplify = false;
+  app.add_flag("--no-simplify", no_simplify,
+               "Do not simplify the formula before the synthesis.");
 
   // options & flags
   std::string filename;
@@ -46,18 +112,46 @@ int main(int argc, char** argv) {
   CLI::Option* file_opt =
       app.add_option("-f,--file", filename, "File to formula.")
           ->check(CLI::ExistingFile);
-  formula_opt->excludes(file_opt);
-  file_opt->excludes(formula_opt);
+  std::string batch_filename;
+  CLI::Option* batch_opt = app.add_option(
+      "-b,--batch", batch_filename,
+      "Stream of synthesis problems, '-' for the standard input. Each "
+      "record has the .inputs and .outputs lines of the partition file, "
+      "a .formula line and an optional .name line; records are separated "
+      "by blank lines. One result line is printed per record.");
+  formula_opt->excludes(file_opt)->excludes(batch_opt);
+  file_opt->excludes(formula_opt)->excludes(batch_opt);
+  batch_opt->excludes(formula_opt)->excludes(file_opt);
   format->add_option(formula_opt);
   format->add_option(file_opt);
+  format->add_option(batch_opt);
   format->require_option(1, 1);
 
   std::string part_file;
   CLI::Option* part_opt = app.add_option("--part", part_file, "Partition file.")
                               ->check(CLI::ExistingFile);
 
+  std::string compiled_file;
+  CLI::Option* compile_opt = app.add_option(
+      "--compile-spec", compiled_file,
+      "Write the formula in binary format to the file, and exit. The file "
+      "can be given to -f in place of the formula.");
+  // the records of a batch carry their own partition, and compiling a
+  // stream of formulas into one file is not supported
+  batch_opt->excludes(part_opt)->excludes(compile_opt);
+
   CLI11_PARSE(app, argc, argv)
 
+  for (auto group_and_option :
+       {std::make_pair(&vtree_options.state, state_order_opt),
+        std::make_pair(&vtree_options.environment, env_order_opt),
+        std::make_pair(&vtree_options.system, system_order_opt)}) {
+    if (group_and_option.second->count() == 0) {
+      group_and_option.first->order = vtree_order;
+    }
+    group_and_option.first->shape = vtree_shape;
+  }
+
   if (version) {
     std::cout << CYNTHIA_VERSION << std::endl;
     return 0;
@@ -67,20 +161,103 @@ int main(int argc, char** argv) {
     cynthia::utils::Logger::level(cynthia::utils::LogLevel::debug);
   }
 
-  auto driver = cynthia::parser::ltlf::LTLfDriver();
-  if (!file_opt->empty()) {
+  auto simplifier_options = no_simplify
+                                ? cynthia::logic::SimplifierOptions::none()
+                                : cynthia::logic::SimplifierOptions{};
+  auto is_realizable = [&](const cynthia::logic::ltlf_ptr& formula,
+                           const cynthia::core::InputOutputPartition&
+                               partition) {
+    return cynthia::core::is_realizable<cynthia::core::ForwardSynthesis>(
+        formula, partition, backend, gc_options, simplifier_options,
+        vtree_search_options, vtree_options);
+  };
+
+  if (!batch_opt->empty()) {
+    if (!verbose) {
+      cynthia::utils::Logger::level(cynthia::utils::LogLevel::error);
+    }
+    std::ifstream batch_file;
+    if (batch_filename != "-") {
+      batch_file.open(batch_filename);
+      if (!batch_file) {
+        logger.error("Cannot open {}", batch_filename);
+        return 1;
+      }
+    }
+    std::istream& in = batch_filename == "-" ? std::cin : batch_file;
+    auto reader = cynthia::core::SpecReader(in);
+    cynthia::core::SpecRecord record;
+    auto context = std::make_shared<cynthia::logic::Context>();
+    try {
+      while (reader.next(record)) {
+        // Records that share atoms share formula nodes as well, so the
+        // context is kept; an unrelated record starts from a fresh one.
+        auto is_known = [&context](const std::string& name) {
+          return context->symbols().contains(name);
+        };
+        if (context->nb_symbols() > 0 and
+            std::none_of(record.input_variables.begin(),
+                         record.input_variables.end(), is_known) and
+            std::none_of(record.output_variables.begin(),
+                         record.output_variables.end(), is_known)) {
+          context = std::make_shared<cynthia::logic::Context>();
+        }
+
+        auto t_start = std::chrono::high_resolution_clock::now();
+        std::string outcome;
+        try {
+          auto parsed_formula =
+              cynthia::parser::ltlf::parse_formula(*context, record.formula);
+          if (no_empty) {
+            parsed_formula = context->make_and(
+                {parsed_formula, context->make_not(context->make_end())});
+          }
+          auto partition = cynthia::core::InputOutputPartition(
+              record.input_variables, record.output_variables);
+          bool result = is_realizable(parsed_formula, partition);
+          outcome = result ? "realizable" : "unrealizable";
+        } catch (const std::exception& e) {
+          outcome = std::string("error: ") + e.what();
+        }
+        auto t_end = std::chrono::high_resolution_clock::now();
+        double elapsed_time =
+            std::chrono::duration<double, std::milli>(t_end - t_start).count();
+        std::cout << record.name << '\t' << outcome << '\t' << elapsed_time
+                  << "ms" << std::endl;
+        context->collect_garbage();
+      }
+    } catch (const std::runtime_error& e) {
+      logger.error("{}", e.what());
+      return 1;
+    }
+    return 0;
+  }
+
+  auto context = std::make_shared<cynthia::logic::Context>();
+  auto driver = cynthia::parser::ltlf::LTLfDriver(context);
+  cynthia::logic::ltlf_ptr parsed_formula;
+  if (!file_opt->empty() and cynthia::logic::is_binary_file(filename)) {
+    logger.info("Loading {}", filename);
+    parsed_formula = cynthia::logic::load_binary(*context, filename);
+  } else if (!file_opt->empty()) {
     logger.info("Parsing {}", filename);
     driver.parse(filename.c_str());
+    parsed_formula = driver.get_result();
   } else {
     std::stringstream formula_stream(formula);
     logger.info("Parsing {}", formula);
     driver.parse(formula_stream);
+    parsed_formula = driver.get_result();
+  }
+
+  if (!compile_opt->empty()) {
+    logger.info("Writing {}", compiled_file);
+    cynthia::logic::save_binary(*parsed_formula, compiled_file);
+    return 0;
   }
 
-  auto parsed_formula = driver.get_result();
   if (no_empty) {
     logger.info("Apply no-empty semantics.");
-    auto context = driver.context;
     auto end = context->make_end();
     auto not_end = context->make_not(end);
     parsed_formula = context->make_and({parsed_formula, not_end});
@@ -94,8 +271,7 @@ int main(int argc, char** argv) {
 
   auto t_start = std::chrono::high_resolution_clock::now();
 
-  bool result = cynthia::core::is_realizable<cynthia::core::ForwardSynthesis>(
-      parsed_formula, partition, enable_gc);
+  bool result = is_realizable(parsed_formula, partition);
   if (result)
     logger.info("realizable.");
   else
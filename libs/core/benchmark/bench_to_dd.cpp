@@ -0,0 +1,62 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark_utils.hpp"
+#include <catch.hpp>
+#include <cynthia/closure.hpp>
+#include <cynthia/core.hpp>
+#include <cynthia/to_dd.hpp>
+
+namespace cynthia {
+namespace core {
+namespace Benchmark {
+
+TEST_CASE("Benchmark closure index lookup", "[core][benchmark][closure]") {
+  auto context = logic::Context();
+  auto n = GENERATE(4, 16, 64);
+  auto formula = make_request_response_formula(context, n);
+  auto partition = make_request_response_partition(n);
+  auto synthesis_context = ForwardSynthesis::Context(formula, partition);
+  const auto& closure = synthesis_context.closure_;
+
+  BENCHMARK("get_id over the whole closure, n=" + std::to_string(n)) {
+    size_t checksum = 0;
+    for (auto it = closure.begin_formulas(); it != closure.end_formulas();
+         ++it) {
+      checksum += closure.get_id(**it);
+    }
+    return checksum;
+  };
+}
+
+TEST_CASE("Benchmark to_dd", "[core][benchmark][to_dd]") {
+  auto context = logic::Context();
+  auto n = GENERATE(4, 16, 64);
+  auto formula = make_request_response_formula(context, n);
+  auto partition = make_request_response_partition(n);
+  auto synthesis_context = ForwardSynthesis::Context(formula, partition);
+
+  // bypass the formula-to-node cache, to measure the translation itself.
+  BENCHMARK("to_dd of the XNF formula, n=" + std::to_string(n)) {
+    auto visitor = ToDdVisitor{synthesis_context, ToDdVisitor::Mode::full};
+    return visitor.apply(*synthesis_context.xnf_formula);
+  };
+}
+
+} // namespace Benchmark
+} // namespace core
+} // namespace cynthia
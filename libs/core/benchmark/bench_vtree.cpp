@@ -0,0 +1,109 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "benchmark_utils.hpp"
+#include <algorithm>
+#include <catch.hpp>
+#include <cynthia/core.hpp>
+#include <cynthia/parser/driver.hpp>
+#include <filesystem>
+
+namespace cynthia {
+namespace core {
+namespace Benchmark {
+
+static const std::filesystem::path
+    DATASETS_FOLDER("libs/core/tests/integration/finite-synthesis-datasets");
+
+static std::string to_string(VariableOrder order) {
+  switch (order) {
+  case VariableOrder::closure:
+    return "closure";
+  case VariableOrder::dfs:
+    return "dfs";
+  case VariableOrder::cooccurrence:
+    return "cooccurrence";
+  case VariableOrder::by_atoms:
+    return "by-atoms";
+  }
+  return "";
+}
+
+static std::string to_string(VtreeShape shape) {
+  return shape == VtreeShape::balanced ? "balanced" : "right-linear";
+}
+
+TEST_CASE("Benchmark vtree orders on the datasets",
+          "[core][benchmark][vtree]") {
+  // the first instance of each dataset, which the integration tests solve
+  auto dataset = GENERATE(as<std::string>{}, "Patterns/Uright",
+                          "Patterns/GFand",
+                          "Two-player-Game/Single-Counter/System-first",
+                          "Two-player-Game/Nim/nim_01/System-first",
+                          "Random/Lydia/case_03_50");
+  auto order = GENERATE(VariableOrder::closure, VariableOrder::dfs,
+                        VariableOrder::cooccurrence, VariableOrder::by_atoms);
+  auto shape = GENERATE(VtreeShape::balanced, VtreeShape::right_linear);
+
+  auto folder = DATASETS_FOLDER / dataset;
+  if (!std::filesystem::is_directory(folder)) {
+    WARN("dataset not found: " + folder.string());
+    return;
+  }
+  std::vector<std::filesystem::path> files;
+  for (auto& entry : std::filesystem::directory_iterator{folder})
+    files.push_back(entry);
+  std::sort(files.begin(), files.end());
+  // the formula file comes before its partition file
+  auto driver = parser::ltlf::LTLfDriver();
+  driver.parse(files[0].c_str());
+  auto formula = driver.context->make_and(
+      {driver.get_result(),
+       driver.context->make_not(driver.context->make_end())});
+  auto partition = InputOutputPartition::read_from_file(files[1]);
+  auto options = VtreeOptions{};
+  options.state = options.environment = options.system = {order, shape};
+
+  BENCHMARK(dataset + ", " + to_string(order) + ", " + to_string(shape)) {
+    return is_realizable<ForwardSynthesis>(
+        formula, partition, Backend::sdd, GcOptions{},
+        logic::SimplifierOptions{}, VtreeSearchOptions{}, options);
+  };
+}
+
+TEST_CASE("Benchmark vtree orders on request-response formulas",
+          "[core][benchmark][vtree]") {
+  auto context = logic::Context();
+  auto n = GENERATE(4, 16);
+  auto order = GENERATE(VariableOrder::closure, VariableOrder::dfs,
+                        VariableOrder::cooccurrence, VariableOrder::by_atoms);
+  auto shape = GENERATE(VtreeShape::balanced, VtreeShape::right_linear);
+  auto formula = make_request_response_formula(context, n);
+  auto partition = make_request_response_partition(n);
+  auto options = VtreeOptions{};
+  options.state = options.environment = options.system = {order, shape};
+
+  BENCHMARK("n=" + std::to_string(n) + ", " + to_string(order) + ", " +
+            to_string(shape)) {
+    return is_realizable<ForwardSynthesis>(
+        formula, partition, Backend::sdd, GcOptions{},
+        logic::SimplifierOptions{}, VtreeSearchOptions{}, options);
+  };
+}
+
+} // namespace Benchmark
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/input_output_partition.hpp>
+#include <cynthia/logic/base.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <string>
+#include <vector>
+
+namespace cynthia {
+namespace core {
+namespace Benchmark {
+
+/*
+ * Build the conjunction, for i in [0, n), of
+ *   G(p_i -> F(q_i)) & (q_i U p_{i+1})
+ * where p_i are input variables and q_i are output variables.
+ */
+inline logic::ltlf_ptr make_request_response_formula(logic::Context& context,
+                                                      size_t n) {
+  logic::vec_ptr conjuncts;
+  for (size_t i = 0; i < n; ++i) {
+    auto p = context.make_atom("p" + std::to_string(i));
+    auto q = context.make_atom("q" + std::to_string(i));
+    auto p_next = context.make_atom("p" + std::to_string(i + 1));
+    auto not_p = context.make_prop_not(p);
+    auto response = context.make_always(
+        context.make_or({not_p, context.make_eventually(q)}));
+    conjuncts.push_back(response);
+    conjuncts.push_back(context.make_until({q, p_next}));
+  }
+  return context.make_and(conjuncts);
+}
+
+inline InputOutputPartition make_request_response_partition(size_t n) {
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+  for (size_t i = 0; i <= n; ++i) {
+    inputs.push_back("p" + std::to_string(i));
+    outputs.push_back("q" + std::to_string(i));
+  }
+  return InputOutputPartition(inputs, outputs);
+}
+
+} // namespace Benchmark
+} // namespace core
+} // namespace cynthia
@@ -1,4 +1,3 @@
-#pragma once
 /*
  * This file is part of Cynthia.
  *
@@ -16,13 +15,6 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cynthia/core.hpp>
-
-namespace cynthia {
-namespace core {
-
-logic::ltlf_ptr sdd_to_formula(SddNode* sdd_node,
-                               ForwardSynthesis::Context& context_);
-
-} // namespace core
-} // namespace cynthia
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this
+// in one cpp file
+#include <catch.hpp>
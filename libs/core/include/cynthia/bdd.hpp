@@ -0,0 +1,143 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cynthia/dd.hpp>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief A reduced ordered BDD manager with complement edges.
+ *
+ * An edge is the index of its node, shifted by one, with the complement
+ * flag in the lowest bit; node 0 is the terminal, so that edge 0 is true
+ * and edge 1 is false. The high edge of a node is never complemented,
+ * which keeps the nodes canonical.
+ *
+ * The nodes are hash-consed in a unique table, and the results of the
+ * conjunctions are kept in a direct-mapped computed table. The variables
+ * are ordered by group, as the decisions of a step: system, environment,
+ * then state variables, so that the moves of each player are the cuts of
+ * a node at a group boundary.
+ *
+ * The reference counts are only those of ref(), not those of the parent
+ * nodes, so the dead nodes are only known by a collection: the nodes
+ * created since the last one count as dead, the others as live.
+ */
+class BddManager : public DdManager {
+private:
+  typedef std::uint32_t edge_t;
+  static constexpr edge_t true_edge = 0;
+  static constexpr edge_t false_edge = 1;
+  static constexpr std::uint32_t free_level = UINT32_MAX;
+
+  struct Node {
+    std::uint32_t level = 0;
+    edge_t low = 0;
+    edge_t high = 0;
+    // next node of the bucket in the unique table, or of the free list
+    std::uint32_t next = 0;
+    std::uint32_t ref_count = 0;
+    // the groups of the support, as a mask of bits 1 << DdGroup
+    std::uint8_t groups = 0;
+    size_t serial = 0;
+  };
+  struct CacheEntry {
+    edge_t first = 0;
+    edge_t second = 0;
+    edge_t result = 0;
+    bool valid = false;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<std::uint32_t> buckets_;
+  std::vector<CacheEntry> cache_;
+  std::vector<size_t> level_to_variable_;
+  std::vector<std::uint32_t> variable_to_level_;
+  std::uint32_t free_list_ = 0;
+  size_t nb_free_nodes_ = 0;
+  size_t next_serial_ = 1;
+  size_t size_after_last_collection_ = 0;
+  // the first level of the environment and of the state variables
+  std::uint32_t env_level_;
+  std::uint32_t state_level_;
+
+  static inline std::uint32_t index_(edge_t edge) { return edge >> 1; }
+  static inline bool is_complemented_(edge_t edge) { return edge & 1; }
+  inline std::uint32_t level_(edge_t edge) const {
+    return nodes_[index_(edge)].level;
+  }
+  inline std::uint8_t groups_(edge_t edge) const {
+    return nodes_[index_(edge)].groups;
+  }
+  static inline size_t hash_(std::uint32_t level, edge_t low, edge_t high) {
+    return (size_t{level} * 12582917 + size_t{low} * 4256249 +
+            size_t{high} * 741457) ^
+           (size_t{high} >> 7);
+  }
+  // the low and high cofactors of the edge with respect to the level
+  std::pair<edge_t, edge_t> cofactors_(edge_t edge, std::uint32_t level) const;
+  edge_t make_node_(std::uint32_t level, edge_t low, edge_t high);
+  void insert_in_bucket_(std::uint32_t index);
+  void resize_buckets_(size_t nb_buckets);
+  edge_t conjoin_(edge_t first, edge_t second);
+  edge_t exists_(edge_t edge, const std::vector<bool>& is_quantified,
+                 std::unordered_map<edge_t, edge_t>& cache);
+  const std::map<edge_t, edge_t>&
+  cut_(edge_t edge, std::uint32_t boundary,
+       std::unordered_map<edge_t, std::map<edge_t, edge_t>>& cache);
+
+  static inline DdNode to_node_(edge_t edge) { return edge; }
+  static inline edge_t to_edge_(DdNode node) {
+    return static_cast<edge_t>(node);
+  }
+
+public:
+  BddManager(size_t nb_state_variables, size_t nb_env_variables,
+             size_t nb_system_variables, size_t cache_size = 1 << 18);
+
+  DdNode dd_true() const override { return to_node_(true_edge); }
+  DdNode dd_false() const override { return to_node_(false_edge); }
+  DdNode literal(long literal) override;
+  DdNode apply(DdNode first, DdNode second, DdOp op) override;
+  DdNode negate(DdNode node) override { return node ^ 1; }
+  DdNode exists(const std::vector<size_t>& variables, DdNode node) override;
+
+  size_t id(DdNode node) const override;
+  long literal_of(DdNode node) const override;
+  DdRegion region(DdNode node) const override;
+  dd_elements_t elements(DdNode node) override;
+  dd_elements_t decompose(DdNode node, DdGroup group) override;
+
+  void ref(DdNode node) override;
+  void deref(DdNode node) override;
+  size_t garbage_collect() override;
+  size_t size() const override { return nodes_.size() - 1 - nb_free_nodes_; }
+  size_t live_size() const override { return size_after_last_collection_; }
+  size_t dead_size() const override {
+    return size() - size_after_last_collection_;
+  }
+  size_t node_size(DdNode node) const override;
+};
+
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,95 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <cynthia/logic/memoizing_visitor.hpp>
+#include <unordered_map>
+#include <utility>
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief A cache of at most max_size entries.
+ *
+ * The entries are kept in two generations: new entries go to the recent
+ * one, and when it holds max_size / 2 entries it replaces the old one,
+ * whose entries are dropped. A hit in the old generation moves the entry
+ * back to the recent one, so the entries in use survive.
+ */
+template <typename Key, typename Value> class BoundedCache {
+private:
+  size_t generation_size_;
+  std::unordered_map<Key, Value> recent_;
+  std::unordered_map<Key, Value> old_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  Value* insert_(const Key& key, Value value) {
+    if (recent_.size() >= generation_size_) {
+      old_ = std::move(recent_);
+      recent_.clear();
+    }
+    return &recent_.insert_or_assign(key, std::move(value)).first->second;
+  }
+
+public:
+  static constexpr size_t default_max_size = 1 << 16;
+
+  explicit BoundedCache(size_t max_size = default_max_size)
+      : generation_size_{max_size < 2 ? 1 : max_size / 2} {}
+
+  /*
+   * Return the cached value, or nullptr if there is none. The pointer is
+   * valid until the next insertion.
+   */
+  const Value* find(const Key& key) {
+    auto it = recent_.find(key);
+    if (it != recent_.end()) {
+      ++hits_;
+      return &it->second;
+    }
+    it = old_.find(key);
+    if (it == old_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    auto value = std::move(it->second);
+    old_.erase(it);
+    return insert_(key, std::move(value));
+  }
+
+  void insert(const Key& key, Value value) { insert_(key, std::move(value)); }
+
+  size_t size() const { return recent_.size() + old_.size(); }
+
+  logic::CacheStats stats() const {
+    return logic::CacheStats{hits_, misses_, size()};
+  }
+
+  void clear() {
+    recent_.clear();
+    old_.clear();
+    hits_ = 0;
+    misses_ = 0;
+  }
+};
+
+} // namespace core
+} // namespace cynthia
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <utility>
 
 namespace cynthia {
@@ -30,14 +31,41 @@ class Closure {
 private:
   std::vector<logic::atom_ptr> atoms;
   logic::vec_ptr from_id_to_subformula;
+  // formulas are hash-consed by their logic::Context, hence the node address
+  // identifies the subformula.
+  std::unordered_map<const logic::LTLfFormula*, size_t> from_subformula_to_id;
+  // the subformulas that are SDD state variables, in the order of the closure
+  logic::vec_ptr from_state_id_to_subformula;
+  std::unordered_map<const logic::LTLfFormula*, size_t>
+      from_subformula_to_state_id;
   friend Closure closure(const logic::LTLfFormula& f);
   explicit Closure(const logic::set_ptr& formulas);
 
+  void build_index_();
+  void build_state_index_();
+
 public:
   Closure() = default;
+  size_t get_id(const logic::LTLfFormula& formula) const;
   size_t get_id(const logic::ltlf_ptr& formula) const;
   const logic::ltlf_ptr& get_formula(size_t index) const;
   inline size_t nb_formulas() const { return from_id_to_subformula.size(); };
+
+  /**
+   * Whether the formula is used as a state literal of the SDDs, i.e. it is
+   * X or WX, tt or ff, end or not_end. The other subformulas of the closure
+   * are expanded into their arguments, hence they do not need a variable.
+   */
+  static bool is_state_variable(const logic::LTLfFormula& formula);
+  /**
+   * \return the index of the formula among the state variables.
+   * \throws std::invalid_argument if the formula is not a state variable
+   */
+  size_t get_state_id(const logic::LTLfFormula& formula) const;
+  const logic::ltlf_ptr& get_state_formula(size_t index) const;
+  inline size_t nb_state_variables() const {
+    return from_state_id_to_subformula.size();
+  };
   inline size_t nb_atoms() const { return atoms.size(); };
   logic::vec_ptr::const_iterator begin_formulas() const;
   logic::vec_ptr::const_iterator end_formulas() const;
@@ -49,6 +77,10 @@ public:
 
 class ClosureVisitor : public logic::Visitor {
 private:
+  // formulas to visit, see apply()
+  logic::vec_ptr pending_;
+  bool running_ = false;
+
   /**
    * Insert a formula in the index, but only if it is not already present.
    * @param formula the formula to add
@@ -93,12 +125,7 @@ Closure closure(const logic::LTLfFormula& f);
 
 inline bool ClosureVisitor::insert_if_not_already_present_(
     const logic::LTLfFormula& formula) {
-  auto formula_ptr = formula.shared_from_this();
-  if (formulas.find(formula_ptr) == formulas.end()) {
-    formulas.insert(formula_ptr);
-    return true;
-  }
-  return false;
+  return formulas.insert(formula.shared_from_this()).second;
 }
 
 inline void
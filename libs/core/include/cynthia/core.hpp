@@ -16,22 +16,32 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cynthia/bounded_cache.hpp>
 #include <cynthia/closure.hpp>
+#include <cynthia/dd.hpp>
+#include <cynthia/gc_policy.hpp>
 #include <cynthia/graph.hpp>
 #include <cynthia/input_output_partition.hpp>
 #include <cynthia/logger.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/simplifier.hpp>
 #include <cynthia/logic/types.hpp>
+#include <cynthia/next_state_formula.hpp>
 #include <cynthia/path.hpp>
-#include <cynthia/sddcpp.hpp>
+#include <cynthia/sdd_dd.hpp>
 #include <cynthia/statistics.hpp>
+#include <cynthia/vtree.hpp>
+#include <cynthia/vtree_cache.hpp>
+#include <cynthia/vtree_minimizer.hpp>
+#include <cynthia/xnf.hpp>
+#include <limits>
+#include <memory>
+#include <unordered_map>
 
-extern "C" {
-#include "sddapi.h"
-}
 namespace cynthia {
 namespace core {
 
-typedef std::map<SddSize, SddNode*> strategy_t;
+typedef std::map<size_t, DdRef> strategy_t;
 
 class ISynthesis {
 public:
@@ -52,6 +62,14 @@ bool is_realizable(const logic::ltlf_ptr& formula,
   return synthesis.is_realizable();
 }
 
+/**
+ * \brief The forward synthesis on a decision diagram.
+ *
+ * The moves of a state are the decompositions of its node at the system
+ * and at the environment variables (see DdManager::decompose), so the
+ * search runs on SDDs as well as on the in-tree BDD manager. The vtree
+ * options only apply to SDDs.
+ */
 class ForwardSynthesis : public ISynthesis {
 public:
   class Context {
@@ -59,39 +77,83 @@ public:
     logic::ltlf_ptr formula;
     logic::Context* ast_manager;
     InputOutputPartition partition;
+    // in negation normal form, after simplification
     logic::ltlf_ptr nnf_formula;
     logic::ltlf_ptr xnf_formula;
     Closure closure_;
     Statistics statistics_;
     Graph graph;
-    std::map<std::string, size_t> prop_to_id;
-    std::map<SddSize, bool> discovered;
-    std::set<SddSize> loop_tags;
-    std::map<SddSize, SddNode*> winning_moves;
-    Vtree* vtree_ = nullptr;
-    SddManager* manager = nullptr;
-    std::map<SddSize, logic::ltlf_ptr> sdd_node_id_to_formula;
-    std::map<logic::ltlf_ptr, SddNode*> formula_to_sdd_node;
+    // the atoms of the partition, inputs first, in variable order
+    logic::vec_ptr partition_atoms;
+    // from atom symbol id to variable index
+    std::vector<size_t> symbol_to_id;
+    VtreeOptions vtree_options;
+    // whether the vtree was read from the vtree cache
+    bool vtree_from_cache = false;
+    std::unique_ptr<DdManager> manager;
+    // the same manager, with the SDD backend
+    SddDdManager* sdd_manager = nullptr;
+    std::vector<size_t> env_variables;
+    std::map<size_t, bool> discovered;
+    std::set<size_t> loop_tags;
+    std::map<size_t, DdRef> winning_moves;
+    BoundedCache<size_t, logic::ltlf_ptr> node_id_to_formula;
+    BoundedCache<logic::ltlf_ptr, DdRef> formula_to_node;
+    // the nodes of the states met by the search: they stay alive, so that
+    // their ids in discovered, loop_tags and graph keep denoting the same
+    // states once formula_to_node dropped their formula
+    std::unordered_map<size_t, DdRef> state_nodes;
+    // shared by the next-state formulas of the search, and released at a
+    // safe point beyond max_formula_cache_size entries
+    XnfVisitor xnf_visitor;
+    NextStateFormulaVisitor next_state_visitor{xnf_visitor};
     utils::Logger logger;
     size_t indentation = 0;
-    const bool use_gc;
-    const float gc_threshold;
-    std::vector<int> controllable_map;
-    std::vector<int> uncontrollable_map;
+    GcPolicy gc_policy;
     Context(const logic::ltlf_ptr& formula,
-            const InputOutputPartition& partition, bool use_gc = false,
-            float gc_threshold = 0.95);
+            const InputOutputPartition& partition,
+            Backend backend = Backend::sdd,
+            const GcOptions& gc_options = GcOptions{},
+            const logic::SimplifierOptions& simplifier_options =
+                logic::SimplifierOptions{},
+            const VtreeSearchOptions& vtree_search_options =
+                VtreeSearchOptions{},
+            const VtreeOptions& vtree_options = VtreeOptions{});
     ~Context() {
-      if (vtree_) {
-        sdd_vtree_free(vtree_);
-      }
-      if (manager) {
-        sdd_manager_free(manager);
-      }
+      // the handles must release their nodes while the manager is alive
+      formula_to_node.clear();
+      state_nodes.clear();
+      winning_moves.clear();
+      graph = Graph{};
     }
 
     logic::ltlf_ptr get_formula(size_t index) const;
-    void call_gc_vtree() const;
+    // an owning handle to a node of the manager
+    inline DdRef make_ref(DdNode node) const { return {node, *manager}; }
+    inline DdRef dd_true() const { return make_ref(manager->dd_true()); }
+    inline DdRef dd_false() const { return make_ref(manager->dd_false()); }
+    inline size_t get_atom_id(const logic::LTLfAtom& atom) const {
+      if (atom.symbol_id >= symbol_to_id.size() or
+          symbol_to_id[atom.symbol_id] == no_id) {
+        throw std::logic_error("cannot find variable " + atom.name +
+                               " in partition");
+      }
+      return symbol_to_id[atom.symbol_id];
+    }
+    // called after the operations of the manager
+    inline void call_gc_vtree() { gc_policy.on_operation(*manager); }
+    // called between two states of the search, when all the nodes in use
+    // are referenced
+    inline void at_safe_point() {
+      gc_policy.at_safe_point(*manager);
+      manager->reorder();
+      release_formulas_();
+    }
+    // whether the search debug messages are printed: the formulas they
+    // show are only built in that case
+    inline bool is_search_debug_enabled() const {
+      return logger.should_log(utils::LogLevel::debug);
+    }
     template <typename Arg1, typename... Args>
     inline void print_search_debug(const char* fmt, const Arg1& arg1,
                                    const Args&... args) const {
@@ -102,17 +164,31 @@ public:
       logger.debug((std::string(indentation, '\t') + fmt).c_str());
     };
 
-    void initialie_maps_();
+  private:
+    static constexpr size_t no_id = std::numeric_limits<size_t>::max();
+    static constexpr size_t max_formula_cache_size = 1 << 16;
+    // the interned formulas after the last collection of ast_manager
+    size_t nb_formulas_after_collection_ = 0;
+    // release the formula caches beyond their bound, and collect the
+    // formulas once their number doubled since the last collection
+    void release_formulas_();
+    void initialize_manager_(Backend backend,
+                             const VtreeSearchOptions& vtree_search_options);
+    void initialize_atoms_();
   };
   ForwardSynthesis(const logic::ltlf_ptr& formula,
                    const InputOutputPartition& partition,
-                   bool enable_gc = false)
-      : context_{formula, partition, enable_gc},
-        ISynthesis(formula, partition){};
+                   Backend backend = Backend::sdd,
+                   const GcOptions& gc_options = GcOptions{},
+                   const logic::SimplifierOptions& simplifier_options =
+                       logic::SimplifierOptions{},
+                   const VtreeSearchOptions& vtree_search_options =
+                       VtreeSearchOptions{},
+                   const VtreeOptions& vtree_options = VtreeOptions{})
+      : ISynthesis(formula, partition),
+        context_{formula, partition, backend, gc_options, simplifier_options,
+                 vtree_search_options, vtree_options} {}
 
-  static std::map<std::string, size_t>
-  compute_prop_to_id_map(const Closure& closure,
-                         const InputOutputPartition& partition);
   bool is_realizable() override;
 
   bool forward_synthesis_();
@@ -120,14 +196,15 @@ public:
 private:
   Context context_;
   strategy_t system_move_(const logic::ltlf_ptr& formula, Path& path);
-  strategy_t env_move_(SddNodeWrapper& wrapper, Path& path);
-  void backprop_success(SddNodeWrapper& wrapper, strategy_t& strategy);
-  SddNodeWrapper next_state_(const SddNodeWrapper& wrapper);
-  logic::ltlf_ptr next_state_formula_(SddNode* wrapper);
-  SddNodeWrapper formula_to_sdd_(const logic::ltlf_ptr& formula);
-  static NodeType node_type_from_sdd_type_(const SddNodeWrapper& wrapper);
-  void add_transition_(const SddNodeWrapper& start, SddNode* move_node,
-                       const SddNodeWrapper& end);
+  strategy_t env_move_(DdNode node, Path& path);
+  void backprop_success(DdNode node, strategy_t& strategy);
+  logic::ltlf_ptr next_state_formula_(DdNode node);
+  DdNode formula_to_node_(const logic::ltlf_ptr& formula);
+  // the decomposition, referenced, since the search may collect the
+  // garbage before the elements are processed
+  std::vector<std::pair<DdRef, DdRef>> decompose_(DdNode node, DdGroup group);
+  NodeType node_type_(DdNode node) const;
+  void add_transition_(DdNode start, DdNode move_node, DdNode end);
 };
 
 } // namespace core
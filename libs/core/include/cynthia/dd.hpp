@@ -0,0 +1,221 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cynthia {
+namespace core {
+
+/*
+ * A node of a decision diagram, as a handle of its manager: an SddNode*
+ * for the SDD manager, an edge for the BDD manager. Handles are only
+ * meaningful to the manager that returned them.
+ */
+typedef std::uintptr_t DdNode;
+typedef std::vector<std::pair<DdNode, DdNode>> dd_elements_t;
+
+enum class Backend { sdd, bdd };
+
+enum class DdOp { conjoin, disjoin };
+
+/*
+ * The groups of variables, in the order in which a step decides them.
+ */
+enum class DdGroup { system, environment, state };
+
+/*
+ * The groups a node depends on. A node that depends on system variables
+ * and on another group is at the root; env_state is the region of the
+ * environment moves.
+ */
+enum class DdRegion { constant, system, environment, state, env_state, root };
+
+/**
+ * \brief The operations of the forward search on a decision diagram.
+ *
+ * The variables are numbered as in the synthesis context: the state
+ * variables first, then the inputs (environment), then the outputs
+ * (system). Literals follow the SDD convention: variable index + 1,
+ * negative for a negated variable.
+ *
+ * Nodes returned by the operations are not referenced: they stay valid
+ * until the next garbage_collect(), unless ref() (or DdRef) keeps them
+ * alive. The managers never collect on their own.
+ */
+class DdManager {
+private:
+  size_t nb_state_variables_;
+  size_t nb_env_variables_;
+  size_t nb_system_variables_;
+
+protected:
+  DdManager(size_t nb_state_variables, size_t nb_env_variables,
+            size_t nb_system_variables)
+      : nb_state_variables_{nb_state_variables},
+        nb_env_variables_{nb_env_variables},
+        nb_system_variables_{nb_system_variables} {}
+
+public:
+  DdManager(const DdManager&) = delete;
+  DdManager& operator=(const DdManager&) = delete;
+  virtual ~DdManager() = default;
+
+  inline size_t nb_variables() const {
+    return nb_state_variables_ + nb_env_variables_ + nb_system_variables_;
+  }
+  DdGroup get_group(size_t variable) const;
+  std::vector<size_t> get_variables(DdGroup group) const;
+
+  virtual DdNode dd_true() const = 0;
+  virtual DdNode dd_false() const = 0;
+  virtual DdNode literal(long literal) = 0;
+  virtual DdNode apply(DdNode first, DdNode second, DdOp op) = 0;
+  virtual DdNode negate(DdNode node) = 0;
+  virtual DdNode exists(const std::vector<size_t>& variables,
+                        DdNode node) = 0;
+  DdNode forall(const std::vector<size_t>& variables, DdNode node) {
+    return negate(exists(variables, negate(node)));
+  }
+  inline DdNode conjoin(DdNode first, DdNode second) {
+    return apply(first, second, DdOp::conjoin);
+  }
+  inline DdNode disjoin(DdNode first, DdNode second) {
+    return apply(first, second, DdOp::disjoin);
+  }
+
+  inline bool is_true(DdNode node) const { return node == dd_true(); }
+  inline bool is_false(DdNode node) const { return node == dd_false(); }
+  /*
+   * An identifier of the node, not reused by another node for the life of
+   * the manager.
+   */
+  virtual size_t id(DdNode node) const = 0;
+  /*
+   * The literal of the node, or 0 if the node is not a literal.
+   */
+  virtual long literal_of(DdNode node) const = 0;
+  virtual DdRegion region(DdNode node) const = 0;
+  /*
+   * The (prime, sub) pairs of a node that is neither a constant nor a
+   * literal: the node is the disjunction of the conjunctions of the pairs,
+   * and the primes are literals (BDD) or over the left vtree (SDD).
+   */
+  virtual dd_elements_t elements(DdNode node) = 0;
+  /*
+   * Split the node between the variables of the group and the variables
+   * of the next groups, as (prime, sub) pairs: the primes are over the
+   * group, mutually exclusive and exhaustive, and the subs are distinct.
+   * A node that does not depend on the group has the single pair
+   * (true, node). The environment group can only split nodes that do not
+   * depend on system variables.
+   */
+  virtual dd_elements_t decompose(DdNode node, DdGroup group) = 0;
+
+  virtual void ref(DdNode node) = 0;
+  virtual void deref(DdNode node) = 0;
+  /*
+   * Free the nodes that are not referenced, nor reachable from a
+   * referenced node.
+   *
+   * \return the number of freed nodes.
+   */
+  virtual size_t garbage_collect() = 0;
+  /*
+   * The number of nodes allocated by the manager, dead or alive.
+   */
+  virtual size_t size() const = 0;
+  /*
+   * The sizes of the nodes in use, of the garbage and of the diagram of a
+   * node, in the unit of the manager: elements for SDDs, nodes for BDDs.
+   */
+  virtual size_t live_size() const = 0;
+  virtual size_t dead_size() const = 0;
+  virtual size_t node_size(DdNode node) const = 0;
+  /*
+   * Look for a better order of the variables, within their groups, if the
+   * manager supports it and grew enough since the last time. It is only
+   * called when all the nodes in use are referenced: the other nodes may
+   * be freed, and the decompositions of the referenced ones may change.
+   *
+   * \return true if the order may have changed.
+   */
+  virtual bool reorder() { return false; }
+};
+
+/*
+ * An owning handle to a node of a DdManager: it holds one reference to the
+ * node for as long as it lives, so that the node survives garbage
+ * collections of the manager. Copies take a new reference, and the
+ * destructor releases it. An empty handle has no manager.
+ *
+ * Handles must be released before their manager is freed.
+ */
+class DdRef {
+private:
+  DdNode node_ = 0;
+  DdManager* manager_ = nullptr;
+
+  struct adopt_tag {};
+  DdRef(DdNode node, DdManager& manager, adopt_tag)
+      : node_{node}, manager_{&manager} {}
+
+public:
+  DdRef() = default;
+  DdRef(DdNode node, DdManager& manager) : node_{node}, manager_{&manager} {
+    manager_->ref(node_);
+  }
+  /*
+   * Take over a reference that the caller already holds, e.g. the result of
+   * a visitor, instead of taking a new one.
+   */
+  static DdRef adopt(DdNode node, DdManager& manager) {
+    return DdRef(node, manager, adopt_tag{});
+  }
+  DdRef(const DdRef& other) : node_{other.node_}, manager_{other.manager_} {
+    if (manager_) {
+      manager_->ref(node_);
+    }
+  }
+  DdRef(DdRef&& other) noexcept
+      : node_{other.node_}, manager_{std::exchange(other.manager_, nullptr)} {}
+  DdRef& operator=(DdRef other) noexcept {
+    std::swap(node_, other.node_);
+    std::swap(manager_, other.manager_);
+    return *this;
+  }
+  ~DdRef() {
+    if (manager_) {
+      manager_->deref(node_);
+    }
+  }
+
+  inline DdNode get() const { return node_; }
+  inline size_t id() const { return manager_->id(node_); }
+  explicit operator bool() const { return manager_ != nullptr; }
+
+  friend bool operator==(const DdRef& a, const DdRef& b) {
+    return a.manager_ == b.manager_ and a.node_ == b.node_;
+  }
+  friend bool operator!=(const DdRef& a, const DdRef& b) { return !(a == b); }
+};
+
+} // namespace core
+} // namespace cynthia
@@ -16,38 +16,52 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cynthia/logic/visitor.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
 
 namespace cynthia {
 namespace core {
 
-class EvalVisitor : public logic::Visitor {
+class EvalVisitor : public logic::StaticMemoizingVisitor<EvalVisitor, bool> {
 private:
-  bool result;
+  friend StaticMemoizingVisitor;
+  // temporal operators are evaluated without looking at their arguments
+  template <typename Function>
+  void for_each_dependency_(const logic::LTLfFormula& formula,
+                            Function function) {
+    if (logic::is_a<logic::LTLfAnd>(formula) or
+        logic::is_a<logic::LTLfOr>(formula)) {
+      logic::for_each_argument(formula, function);
+    }
+  }
 
 public:
-  void visit(const logic::LTLfTrue&) override;
-  void visit(const logic::LTLfFalse&) override;
-  void visit(const logic::LTLfPropTrue&) override;
-  void visit(const logic::LTLfPropFalse&) override;
-  void visit(const logic::LTLfAtom&) override;
-  void visit(const logic::LTLfNot&) override;
-  void visit(const logic::LTLfPropositionalNot&) override;
-  void visit(const logic::LTLfAnd&) override;
-  void visit(const logic::LTLfOr&) override;
-  void visit(const logic::LTLfImplies&) override;
-  void visit(const logic::LTLfEquivalent&) override;
-  void visit(const logic::LTLfXor&) override;
-  void visit(const logic::LTLfNext&) override;
-  void visit(const logic::LTLfWeakNext&) override;
-  void visit(const logic::LTLfUntil&) override;
-  void visit(const logic::LTLfRelease&) override;
-  void visit(const logic::LTLfEventually&) override;
-  void visit(const logic::LTLfAlways&) override;
-
-  bool apply(const logic::LTLfFormula& formula);
+  bool visit(const logic::LTLfTrue&);
+  bool visit(const logic::LTLfFalse&);
+  bool visit(const logic::LTLfPropTrue&);
+  bool visit(const logic::LTLfPropFalse&);
+  bool visit(const logic::LTLfAtom&);
+  bool visit(const logic::LTLfNot&);
+  bool visit(const logic::LTLfPropositionalNot&);
+  bool visit(const logic::LTLfAnd&);
+  bool visit(const logic::LTLfOr&);
+  bool visit(const logic::LTLfImplies&);
+  bool visit(const logic::LTLfEquivalent&);
+  bool visit(const logic::LTLfXor&);
+  bool visit(const logic::LTLfNext&);
+  bool visit(const logic::LTLfWeakNext&);
+  bool visit(const logic::LTLfUntil&);
+  bool visit(const logic::LTLfRelease&);
+  bool visit(const logic::LTLfEventually&);
+  bool visit(const logic::LTLfAlways&);
 };
 
+/*
+ * Whether the empty trace satisfies the formula.
+ *
+ * The answer is computed when the node is built (see
+ * logic::FormulaAttributes), so this is O(1). EvalVisitor computes the same
+ * value by visiting a formula in NNF.
+ */
 bool eval(const logic::LTLfFormula& formula);
 
 } // namespace core
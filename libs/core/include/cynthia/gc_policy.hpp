@@ -0,0 +1,109 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cynthia/dd.hpp>
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief Options of the garbage collection of the decision diagram manager.
+ *
+ * Sizes are in the unit of the manager, as reported by
+ * DdManager::live_size and DdManager::dead_size.
+ */
+struct GcOptions {
+  bool enabled = false;
+  // collect when the dead part of the manager is at least this fraction
+  float dead_ratio = 0.95;
+  // collect, whatever the dead ratio, when live + dead exceeds it (0: none)
+  std::size_t memory_budget = 0;
+  // over the memory budget, collect only when the dead part is at least
+  // this fraction of the budget, so that a manager whose live part is
+  // close to the budget is not collected at every check
+  float budget_dead_ratio = 0.1;
+  // do not collect before the manager grew by this much since the last
+  // collection
+  std::size_t allocation_step = 0;
+  // do not collect more often than this
+  std::chrono::milliseconds min_interval{0};
+  // the number of operations between two checks
+  std::size_t check_interval = 16;
+  // collect only at safe points, i.e. between two states of the search
+  bool safe_points_only = false;
+};
+
+struct GcStatistics {
+  std::size_t nb_checks = 0;
+  std::size_t nb_collections = 0;
+  std::size_t freed_size = 0;
+  double total_pause_ms = 0;
+  double max_pause_ms = 0;
+};
+
+/**
+ * \brief Decides when to collect the garbage of a decision diagram manager.
+ *
+ * on_operation() is meant to be called after each operation, and is
+ * cheap: it only checks the manager every check_interval calls.
+ * at_safe_point() always checks it.
+ */
+class GcPolicy {
+private:
+  GcOptions options_;
+  GcStatistics statistics_;
+  std::size_t nb_operations_ = 0;
+  std::size_t size_after_last_collection_ = 0;
+  std::chrono::steady_clock::time_point last_collection_{};
+
+  bool should_collect_(std::size_t live_size, std::size_t dead_size) const;
+  void collect_(DdManager& manager, std::size_t live_size,
+                std::size_t dead_size);
+
+public:
+  explicit GcPolicy(const GcOptions& options = GcOptions{})
+      : options_{options} {}
+
+  inline void on_operation(DdManager& manager) {
+    if (!options_.enabled or options_.safe_points_only or
+        ++nb_operations_ < options_.check_interval) {
+      return;
+    }
+    nb_operations_ = 0;
+    check(manager);
+  }
+  inline void at_safe_point(DdManager& manager) {
+    if (options_.enabled) {
+      check(manager);
+    }
+  }
+  /**
+   * Collect the garbage of the manager if the options say so.
+   *
+   * \return true if a collection happened.
+   */
+  bool check(DdManager& manager);
+
+  const GcOptions& options() const { return options_; }
+  const GcStatistics& statistics() const { return statistics_; }
+};
+
+} // namespace core
+} // namespace cynthia
@@ -16,12 +16,10 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cynthia/dd.hpp>
 #include <map>
 #include <set>
 #include <string>
-extern "C" {
-#include "sddapi.h"
-}
 
 namespace cynthia {
 namespace core {
@@ -39,14 +37,17 @@ struct Node {
   }
 };
 
-class Graph {
+/*
+ * The transitions of the search, by action id. The actions themselves are
+ * kept by BasicGraph.
+ */
+class GraphBase {
 
 private:
   std::map<Node, std::map<size_t, Node>> transitions;
   // backward transitions might be non-deterministic
   std::map<Node, std::map<size_t, std::set<Node>>> backward_transitions;
 
-  std::map<SddSize, SddNode*> action_by_id;
   static void insert_with_default_(std::map<Node, std::map<size_t, Node>>& m,
                                    Node start, size_t action, Node end);
   static void insert_backward_with_default_(
@@ -62,12 +63,35 @@ private:
     return item_or_end->second;
   }
 
+protected:
+  void add_transition_(Node start, size_t action_id, Node end);
+
 public:
-  void add_transition(Node start, SddNode* action, Node end);
-  SddNode* get_action_by_id(SddSize action_id) const;
   std::map<size_t, Node> get_successors(Node start) const;
   std::map<size_t, std::set<Node>> get_predecessors(Node end) const;
 };
 
+/*
+ * A graph of the search whose actions are handles to diagram nodes, i.e.
+ * DdRef; Action must provide id().
+ */
+template <typename Action> class BasicGraph : public GraphBase {
+
+private:
+  std::map<size_t, Action> action_by_id;
+
+public:
+  void add_transition(Node start, const Action& action, Node end) {
+    size_t action_id = action.id();
+    action_by_id[action_id] = action;
+    add_transition_(start, action_id, end);
+  }
+  const Action& get_action_by_id(size_t action_id) const {
+    return action_by_id.at(action_id);
+  }
+};
+
+typedef BasicGraph<DdRef> Graph;
+
 } // namespace core
 } // namespace cynthia
@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/logic/memoizing_visitor.hpp>
+#include <cynthia/xnf.hpp>
+
+namespace cynthia {
+namespace core {
+
+/*
+ * Compute xnf(strip_next(formula)) in a single traversal.
+ *
+ * The input is a formula in Next-Normal Form, as the ones read back from
+ * the SDD of a state. X(phi) becomes (xnf(phi) & not_end), WX(phi) becomes
+ * (xnf(phi) | end), and the boolean structure is rebuilt once. The XNF of
+ * the arguments of the next operators is delegated to an XnfVisitor, so
+ * that it can be shared with other transformations of the same session.
+ */
+class NextStateFormulaVisitor
+    : public logic::StaticMemoizingVisitor<NextStateFormulaVisitor,
+                                           logic::ltlf_ptr> {
+private:
+  friend StaticMemoizingVisitor;
+  XnfVisitor& xnf_visitor_;
+
+  // only the boolean structure is rebuilt by this visitor
+  template <typename Function>
+  void for_each_dependency_(const logic::LTLfFormula& formula,
+                            Function function) {
+    if (logic::is_boolean_connective(formula)) {
+      logic::for_each_argument(formula, function);
+    }
+  }
+
+public:
+  explicit NextStateFormulaVisitor(XnfVisitor& xnf_visitor)
+      : xnf_visitor_{xnf_visitor} {}
+  logic::ltlf_ptr visit(const logic::LTLfTrue&);
+  logic::ltlf_ptr visit(const logic::LTLfFalse&);
+  logic::ltlf_ptr visit(const logic::LTLfPropTrue&);
+  logic::ltlf_ptr visit(const logic::LTLfPropFalse&);
+  logic::ltlf_ptr visit(const logic::LTLfAtom&);
+  logic::ltlf_ptr visit(const logic::LTLfNot&);
+  logic::ltlf_ptr visit(const logic::LTLfPropositionalNot&);
+  logic::ltlf_ptr visit(const logic::LTLfAnd&);
+  logic::ltlf_ptr visit(const logic::LTLfOr&);
+  logic::ltlf_ptr visit(const logic::LTLfImplies&);
+  logic::ltlf_ptr visit(const logic::LTLfEquivalent&);
+  logic::ltlf_ptr visit(const logic::LTLfXor&);
+  logic::ltlf_ptr visit(const logic::LTLfNext&);
+  logic::ltlf_ptr visit(const logic::LTLfWeakNext&);
+  logic::ltlf_ptr visit(const logic::LTLfUntil&);
+  logic::ltlf_ptr visit(const logic::LTLfRelease&);
+  logic::ltlf_ptr visit(const logic::LTLfEventually&);
+  logic::ltlf_ptr visit(const logic::LTLfAlways&);
+};
+
+logic::ltlf_ptr next_state_formula(const logic::LTLfFormula& formula);
+
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,93 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/dd.hpp>
+#include <cynthia/sddcpp.hpp>
+#include <cynthia/vtree_minimizer.hpp>
+
+extern "C" {
+#include "sddapi.h"
+}
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief The DdManager interface of an SDD manager.
+ *
+ * The vtree must keep the system variables on the left of the root, and
+ * the environment and the state variables on the left and on the right of
+ * its right child (see VTreeBuilder): the decompositions are then the
+ * elements of the nodes. The automatic garbage collection of the manager
+ * is disabled, and the vtree search of reorder() keeps that structure
+ * (see VtreeMinimizer).
+ */
+class SddDdManager : public DdManager {
+private:
+  Vtree* vtree_;
+  SddManager* manager_;
+  VtreeRegions regions_;
+  VtreeMinimizer vtree_minimizer_;
+
+  static inline SddNode* to_sdd_(DdNode node) {
+    return reinterpret_cast<SddNode*>(node);
+  }
+  static inline DdNode to_node_(SddNode* node) {
+    return reinterpret_cast<DdNode>(node);
+  }
+
+public:
+  /*
+   * The manager takes the ownership of the vtree.
+   */
+  SddDdManager(size_t nb_state_variables, size_t nb_env_variables,
+               size_t nb_system_variables, Vtree* vtree,
+               const VtreeSearchOptions& vtree_search_options =
+                   VtreeSearchOptions{});
+  ~SddDdManager() override;
+
+  inline SddManager* get_manager() const { return manager_; }
+  inline const VtreeMinimizer& vtree_minimizer() const {
+    return vtree_minimizer_;
+  }
+
+  DdNode dd_true() const override;
+  DdNode dd_false() const override;
+  DdNode literal(long literal) override;
+  DdNode apply(DdNode first, DdNode second, DdOp op) override;
+  DdNode negate(DdNode node) override;
+  DdNode exists(const std::vector<size_t>& variables, DdNode node) override;
+
+  size_t id(DdNode node) const override;
+  long literal_of(DdNode node) const override;
+  DdRegion region(DdNode node) const override;
+  dd_elements_t elements(DdNode node) override;
+  dd_elements_t decompose(DdNode node, DdGroup group) override;
+
+  void ref(DdNode node) override;
+  void deref(DdNode node) override;
+  size_t garbage_collect() override;
+  size_t size() const override;
+  size_t live_size() const override;
+  size_t dead_size() const override;
+  size_t node_size(DdNode node) const override;
+  bool reorder() override;
+};
+
+} // namespace core
+} // namespace cynthia
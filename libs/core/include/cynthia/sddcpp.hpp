@@ -19,6 +19,8 @@
 #include <cstddef>  // For std::ptrdiff_t
 #include <iterator> // For std::forward_iterator_tag
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 extern "C" {
 #include "sddapi.h"
@@ -79,20 +81,42 @@ private:
   SddNode** m_ptr_;
 };
 
+/*
+ * The region of each node of the vtree of a manager, by vtree position:
+ * the system variables are on the left of the root, and the environment
+ * and the state variables on the left and on the right of its right child.
+ *
+ * The positions change when the vtree does, so the regions must be
+ * computed again after a vtree search.
+ */
+class VtreeRegions {
+private:
+  std::vector<SddNodeType> types_;
+
+public:
+  VtreeRegions() = default;
+  explicit VtreeRegions(const SddManager* manager);
+
+  inline SddNodeType get(const Vtree* vtree) const {
+    return vtree == nullptr ? UNDEFINED : types_[vtree->position];
+  }
+};
+
+/*
+ * A view of an SDD node: it does not hold a reference to the node, and it
+ * is trivially copyable.
+ */
 class SddNodeWrapper {
 private:
-  SddSize id_;
+  SddSize id_ = 0;
   SddNode* raw_{};
   SddNodeSize nb_children_ = 0;
   SddNode** children_ = nullptr;
-  SddNodeType type_;
-  SddManager* manager_;
-
-  SddNodeType get_sdd_node_type_() const;
+  SddNodeType type_ = UNDEFINED;
 
 public:
   SddNodeWrapper() = default;
-  SddNodeWrapper(SddNode* raw, SddManager* manager);
+  SddNodeWrapper(SddNode* raw, const VtreeRegions& regions);
   inline SddNode* get_raw() const { return raw_; }
   inline SddNodeType get_type() const { return type_; }
   inline SddSize get_id() const { return id_; }
@@ -108,5 +132,8 @@ public:
   SddNodeChildrenIterator end() const;
 };
 
+static_assert(std::is_trivially_copyable<SddNodeWrapper>::value,
+              "SddNodeWrapper must stay a trivially copyable view");
+
 } // namespace core
 } // namespace cynthia
@@ -0,0 +1,80 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief A synthesis problem read from a spec stream.
+ */
+struct SpecRecord {
+  std::string name;
+  std::string formula;
+  std::vector<std::string> input_variables;
+  std::vector<std::string> output_variables;
+  /// The line of the stream where the record starts.
+  std::size_t line_number = 0;
+};
+
+/**
+ * \brief Reads synthesis problems one after another from a text stream.
+ *
+ * Records are separated by blank lines and use the same syntax of the
+ * partition file, plus the formula and an optional name:
+ *   .name: arbiter
+ *   .inputs: r1 r2
+ *   .outputs: g1 g2
+ *   .formula: G(r1 -> F(g1)) & G(r2 -> F(g2))
+ *             & G(!(g1 & g2))
+ *
+ * Lines that do not start with a dot continue the formula, so long
+ * formulas can be split. Lines starting with '#' are comments. Records
+ * without a name are named after their position in the stream.
+ */
+class SpecReader {
+private:
+  std::istream& in_;
+  std::size_t line_number_ = 0;
+  std::size_t nb_records_ = 0;
+
+  static std::runtime_error bad_format_exception_(std::size_t line_number,
+                                                  const std::string& message);
+
+public:
+  explicit SpecReader(std::istream& in) : in_{in} {}
+
+  /**
+   * \brief Reads the next record.
+   *
+   * \param record the record to fill.
+   * \return false if the stream has no more records.
+   * \throws std::runtime_error if the record is malformed.
+   */
+  bool next(SpecRecord& record);
+
+  std::size_t nb_records() const { return nb_records_; }
+};
+
+} // namespace core
+} // namespace cynthia
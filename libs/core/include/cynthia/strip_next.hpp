@@ -16,14 +16,20 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cynthia/logic/visitor.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
 
 namespace cynthia {
 namespace core {
 
-class StripNextVisitor : public logic::Visitor {
-private:
-  logic::ltlf_ptr result;
+class StripNextVisitor : public logic::MemoizingVisitor<logic::ltlf_ptr> {
+protected:
+  // only the boolean structure is rebuilt by this visitor
+  void for_each_dependency_(const logic::LTLfFormula& formula,
+                            const DependencyFunction& function) override {
+    if (logic::is_boolean_connective(formula)) {
+      MemoizingVisitor::for_each_dependency_(formula, function);
+    }
+  }
 
 public:
   StripNextVisitor() = default;
@@ -45,8 +51,6 @@ public:
   void visit(const logic::LTLfRelease&) override;
   void visit(const logic::LTLfEventually&) override;
   void visit(const logic::LTLfAlways&) override;
-
-  logic::ltlf_ptr apply(const logic::LTLfFormula& formula);
 };
 
 logic::ltlf_ptr strip_next(const logic::LTLfFormula& formula);
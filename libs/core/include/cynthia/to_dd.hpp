@@ -0,0 +1,143 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/core.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
+#include <utility>
+#include <vector>
+
+namespace cynthia {
+namespace core {
+
+/*
+ * The node of a formula. In full mode the formula is in XNF, and tt, ff,
+ * X, WX and the end formulas are state variables. In the realizability
+ * mode, the next-state operators take their value on a trace that ends
+ * after one step (X is ff, WX is tt), and in the unrealizability mode the
+ * most permissive one (tt); the temporal operators are reduced accordingly
+ * (see for_each_dependency_).
+ *
+ * Each result holds a reference: the cache owns one, and each caller of
+ * apply() gets its own, so that the garbage can be collected between two
+ * operations (see ForwardSynthesis::Context::call_gc_vtree).
+ */
+class ToDdVisitor : public logic::StaticMemoizingVisitor<ToDdVisitor, DdNode> {
+public:
+  enum class Mode { full, realizability, unrealizability };
+
+private:
+  friend StaticMemoizingVisitor;
+  Mode mode_;
+
+  void retain_result_(const DdNode& node) { context_.manager->ref(node); }
+  // a referenced node, for the cache
+  inline DdNode own_(DdNode node) const {
+    context_.manager->ref(node);
+    return node;
+  }
+
+  template <typename Function>
+  void for_each_dependency_(const logic::LTLfFormula& formula,
+                            Function function) {
+    switch (formula.get_type_code()) {
+    case logic::TypeID::t_LTLfAnd:
+    case logic::TypeID::t_LTLfOr:
+      logic::for_each_argument(formula, function);
+      break;
+    case logic::TypeID::t_LTLfImplies:
+      if (mode_ == Mode::full) {
+        logic::for_each_argument(formula, function);
+      }
+      break;
+    case logic::TypeID::t_LTLfUntil:
+      if (mode_ == Mode::unrealizability) {
+        logic::for_each_argument(formula, function);
+      } else if (mode_ == Mode::realizability) {
+        function(*static_cast<const logic::LTLfBinaryOp&>(formula).args.back());
+      }
+      break;
+    case logic::TypeID::t_LTLfRelease:
+      if (mode_ != Mode::full) {
+        function(*static_cast<const logic::LTLfBinaryOp&>(formula).args.back());
+      }
+      break;
+    case logic::TypeID::t_LTLfEventually:
+      if (mode_ == Mode::realizability) {
+        logic::for_each_argument(formula, function);
+      }
+      break;
+    case logic::TypeID::t_LTLfAlways:
+      if (mode_ != Mode::full) {
+        logic::for_each_argument(formula, function);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  DdNode state_literal_(const logic::LTLfFormula& formula) const;
+  DdNode atom_(const logic::LTLfAtom& atom, bool negated) const;
+  DdNode nary_apply_(const logic::LTLfBinaryOp& formula, DdOp op);
+
+public:
+  ForwardSynthesis::Context& context_;
+  ToDdVisitor(ForwardSynthesis::Context& context, Mode mode)
+      : mode_{mode}, context_{context} {}
+  ~ToDdVisitor();
+  DdNode visit(const logic::LTLfTrue&);
+  DdNode visit(const logic::LTLfFalse&);
+  DdNode visit(const logic::LTLfPropTrue&);
+  DdNode visit(const logic::LTLfPropFalse&);
+  DdNode visit(const logic::LTLfAtom&);
+  DdNode visit(const logic::LTLfNot&);
+  DdNode visit(const logic::LTLfPropositionalNot&);
+  DdNode visit(const logic::LTLfAnd&);
+  DdNode visit(const logic::LTLfOr&);
+  DdNode visit(const logic::LTLfImplies&);
+  DdNode visit(const logic::LTLfEquivalent&);
+  DdNode visit(const logic::LTLfXor&);
+  DdNode visit(const logic::LTLfNext&);
+  DdNode visit(const logic::LTLfWeakNext&);
+  DdNode visit(const logic::LTLfUntil&);
+  DdNode visit(const logic::LTLfRelease&);
+  DdNode visit(const logic::LTLfEventually&);
+  DdNode visit(const logic::LTLfAlways&);
+
+  DdNode apply(const logic::LTLfFormula& formula);
+};
+
+/*
+ * The node of the XNF formula, kept alive by the cache of the context.
+ */
+DdNode to_dd(const logic::LTLfFormula& formula,
+             ForwardSynthesis::Context& context);
+
+/*
+ * The disjunction of the (prime, sub) formulas of a decision node, with the
+ * primes of each sub grouped: (p1 & s) | (p2 & s) is built as (p1 | p2) & s.
+ * The elements with an ff sub are dropped.
+ */
+logic::ltlf_ptr factored_or(
+    const std::vector<std::pair<logic::ltlf_ptr, logic::ltlf_ptr>>& elements,
+    logic::Context& context);
+
+logic::ltlf_ptr dd_to_formula(DdNode node, ForwardSynthesis::Context& context);
+
+} // namespace core
+} // namespace cynthia
@@ -23,6 +23,8 @@
 #include <memory>
 #include <queue>
 #include <set>
+#include <string>
+#include <unordered_map>
 extern "C" {
 #include "sddapi.h"
 }
@@ -30,6 +32,45 @@ extern "C" {
 namespace cynthia {
 namespace core {
 
+/**
+ * \brief The order of the variables within a group of the vtree.
+ *
+ * - closure: the order of the closure, for the state variables, and of the
+ *   partition file, for the environment and the system variables.
+ * - dfs: the order of the first occurrence in a depth-first visit of the
+ *   formula. A state variable occurs where its argument occurs.
+ * - cooccurrence: a greedy clustering, in which each variable is followed by
+ *   the one that shares the most with it. State variables share atoms, and
+ *   atoms share the state variables they occur in.
+ * - by_atoms: the state variables follow the order of their first atom in
+ *   the environment and system groups. The state variables cannot be
+ *   interleaved with the atoms, since each group must stay in its own
+ *   sub-vtree; this aligns the orders instead. It is the same as dfs for
+ *   the environment and the system variables.
+ */
+enum class VariableOrder { closure, dfs, cooccurrence, by_atoms };
+
+/**
+ * \brief The shape of the vtree of a group of variables.
+ *
+ * - balanced: the leaves are paired level by level.
+ * - right_linear: each internal node has a leaf on its left.
+ */
+enum class VtreeShape { balanced, right_linear };
+
+struct VtreeGroupOptions {
+  VariableOrder order = VariableOrder::closure;
+  VtreeShape shape = VtreeShape::balanced;
+};
+
+struct VtreeOptions {
+  VtreeGroupOptions system;
+  VtreeGroupOptions environment;
+  VtreeGroupOptions state;
+  // the directory of the vtree cache (see VtreeCache); empty to disable it
+  std::string cache_directory;
+};
+
 class VTreeNode;
 typedef std::shared_ptr<VTreeNode> vtree_node_ptr;
 
@@ -51,9 +92,13 @@ private:
   vtree_node_ptr state_root_;
   const Closure& closure_;
   const InputOutputPartition& partition_;
+  VtreeOptions options_;
+  logic::ltlf_ptr formula_;
 
   bool executed = false;
   Vtree* result{};
+  std::unordered_map<const logic::LTLfFormula*, size_t> dfs_positions_cache_;
+  bool dfs_visited_ = false;
 
   /**
    * Check that the set of variables declared in the partition is a superset
@@ -61,14 +106,52 @@ private:
    */
   void check_partition_superset_of_atoms() const;
 
+  // the order of the variables of each group, as indexes within the group
+  std::vector<size_t> state_order_(const std::vector<size_t>& env_order,
+                                   const std::vector<size_t>& system_order);
+  std::vector<size_t> atom_order_(const std::vector<std::string>& names,
+                                  VariableOrder order);
+  // the position of the first occurrence of each subformula
+  const std::unordered_map<const logic::LTLfFormula*, size_t>&
+  dfs_positions_();
+
 public:
-  VTreeBuilder(const Closure& closure, const InputOutputPartition& partition);
+  /**
+   * \param formula the formula of the closure, for the dfs order. If it is
+   * not given, the closure formulas are visited in order.
+   */
+  VTreeBuilder(const Closure& closure, const InputOutputPartition& partition,
+               const VtreeOptions& options = VtreeOptions{},
+               logic::ltlf_ptr formula = nullptr);
 
   Vtree* get_vtree();
-  static std::vector<vtree_node_ptr> build_leaves(size_t size, size_t offset);
+  static std::vector<vtree_node_ptr>
+  build_leaves(const std::vector<size_t>& order, size_t offset);
   static vtree_node_ptr
   build_binary_tree_from_list(const std::vector<vtree_node_ptr>& leaves);
+  static vtree_node_ptr
+  build_right_linear_tree_from_list(const std::vector<vtree_node_ptr>& leaves);
+  static vtree_node_ptr build_tree(const std::vector<vtree_node_ptr>& leaves,
+                                   VtreeShape shape);
+  /**
+   * Order the variables greedily, so that each one is followed by the one
+   * that shares the most features with it. Ties, and the first variable,
+   * go to the variable with the most features and then to the lowest index.
+   *
+   * \param features the sorted features of each variable.
+   * \return the indexes of the variables, in order.
+   */
+  static std::vector<size_t>
+  cooccurrence_order(const std::vector<std::vector<size_t>>& features);
   static std::string print_vtree(const vtree_node_ptr& root);
+  // in the same format, with the nodes numbered in post-order
+  static std::string print_vtree(const Vtree* root);
+  /**
+   * Read a vtree in the format of sdd_vtree_read, without going through the
+   * file system when possible: the library reads vtrees only from files, so
+   * the string is given to it as an anonymous in-memory file.
+   */
+  static Vtree* read_vtree(const std::string& vtree_string);
 };
 
 } // namespace core
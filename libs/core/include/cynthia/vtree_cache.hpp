@@ -0,0 +1,78 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/closure.hpp>
+#include <cynthia/input_output_partition.hpp>
+#include <filesystem>
+#include <string>
+
+extern "C" {
+#include "sddapi.h"
+}
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief An on-disk cache of vtrees, e.g. of the vtrees found by the
+ * dynamic vtree search, so that the next solves of the same specification
+ * start from a good variable order.
+ *
+ * The entries are keyed by a hash of the state variables of the closure
+ * and of the partition, which determine the SDD variables. A vtree read
+ * from the cache is used only if it has the same variables and keeps the
+ * system, environment and state variables in their sub-vtrees (see
+ * VTreeBuilder); otherwise it is ignored.
+ */
+class VtreeCache {
+private:
+  std::filesystem::path directory_;
+
+  std::filesystem::path path_(const Closure& closure,
+                              const InputOutputPartition& partition) const;
+
+public:
+  explicit VtreeCache(std::filesystem::path directory)
+      : directory_{std::move(directory)} {}
+
+  static std::string key(const Closure& closure,
+                         const InputOutputPartition& partition);
+  /**
+   * Check that the vtree has the variables of the closure and of the
+   * partition, each group in its own sub-vtree.
+   */
+  static bool is_compatible(const Vtree* vtree, const Closure& closure,
+                            const InputOutputPartition& partition);
+
+  /**
+   * \return the cached vtree, to be freed by the caller, or nullptr if
+   * there is no compatible vtree in the cache.
+   */
+  Vtree* load(const Closure& closure,
+              const InputOutputPartition& partition) const;
+  /**
+   * Store the vtree, replacing the previous entry.
+   *
+   * \return false if the vtree could not be written.
+   */
+  bool save(const Closure& closure, const InputOutputPartition& partition,
+            const Vtree* vtree) const;
+};
+
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,90 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+
+extern "C" {
+#include "sddapi.h"
+}
+
+namespace cynthia {
+namespace core {
+
+/**
+ * \brief Options of the dynamic vtree search.
+ */
+struct VtreeSearchOptions {
+  bool enabled = false;
+  // the time limit of each search, in seconds
+  float time_limit = 10;
+  // search again when the live size grew by this factor since the last search
+  float growth_factor = 2;
+  // do not search while the live size is smaller than this
+  SddSize min_live_size = 10000;
+  // use the limited search of the library, which also bounds the size and
+  // the time of each vtree operation
+  bool limited = true;
+};
+
+struct VtreeSearchStatistics {
+  std::size_t nb_searches = 0;
+  SddSize live_size_before = 0;
+  SddSize live_size_after = 0;
+  double total_time_ms = 0;
+};
+
+/**
+ * \brief Searches for a better vtree at the safe points of the search.
+ *
+ * The vtree has the system variables on the left of the root, and the
+ * environment and the state variables on the left and on the right of its
+ * right child, which is what SddNodeWrapper relies on to classify the nodes.
+ * The search is run separately on each of the three sub-vtrees, so that the
+ * variables can be reordered only within their own group.
+ *
+ * All the nodes in use must be referenced when the search runs: the other
+ * nodes are garbage collected, and the decompositions of the referenced
+ * ones change with the vtree.
+ */
+class VtreeMinimizer {
+private:
+  VtreeSearchOptions options_;
+  VtreeSearchStatistics statistics_;
+  SddSize live_size_after_last_search_ = 0;
+
+  void search_(SddManager* manager);
+
+public:
+  explicit VtreeMinimizer(
+      const VtreeSearchOptions& options = VtreeSearchOptions{})
+      : options_{options} {}
+
+  /**
+   * Search for a better vtree, if the manager grew enough since the last
+   * search.
+   *
+   * \return true if a search was run.
+   */
+  bool at_safe_point(SddManager* manager);
+
+  const VtreeSearchOptions& options() const { return options_; }
+  const VtreeSearchStatistics& statistics() const { return statistics_; }
+};
+
+} // namespace core
+} // namespace cynthia
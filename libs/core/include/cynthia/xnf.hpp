@@ -16,36 +16,49 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cynthia/logic/visitor.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
 
 namespace cynthia {
 namespace core {
 
-class XnfVisitor : public logic::Visitor {
+class XnfVisitor
+    : public logic::StaticMemoizingVisitor<XnfVisitor, logic::ltlf_ptr> {
 private:
-  logic::ltlf_ptr result;
+  friend StaticMemoizingVisitor;
+  // the arguments of X and WX are left untouched
+  template <typename Function>
+  void for_each_dependency_(const logic::LTLfFormula& formula,
+                            Function function) {
+    switch (formula.get_type_code()) {
+    case logic::TypeID::t_LTLfNot:
+    case logic::TypeID::t_LTLfPropNot:
+    case logic::TypeID::t_LTLfNext:
+    case logic::TypeID::t_LTLfWeakNext:
+      break;
+    default:
+      logic::for_each_argument(formula, function);
+    }
+  }
 
 public:
-  void visit(const logic::LTLfTrue&) override;
-  void visit(const logic::LTLfFalse&) override;
-  void visit(const logic::LTLfPropTrue&) override;
-  void visit(const logic::LTLfPropFalse&) override;
-  void visit(const logic::LTLfAtom&) override;
-  void visit(const logic::LTLfNot&) override;
-  void visit(const logic::LTLfPropositionalNot&) override;
-  void visit(const logic::LTLfAnd&) override;
-  void visit(const logic::LTLfOr&) override;
-  void visit(const logic::LTLfImplies&) override;
-  void visit(const logic::LTLfEquivalent&) override;
-  void visit(const logic::LTLfXor&) override;
-  void visit(const logic::LTLfNext&) override;
-  void visit(const logic::LTLfWeakNext&) override;
-  void visit(const logic::LTLfUntil&) override;
-  void visit(const logic::LTLfRelease&) override;
-  void visit(const logic::LTLfEventually&) override;
-  void visit(const logic::LTLfAlways&) override;
-
-  logic::ltlf_ptr apply(const logic::LTLfFormula& formula);
+  logic::ltlf_ptr visit(const logic::LTLfTrue&);
+  logic::ltlf_ptr visit(const logic::LTLfFalse&);
+  logic::ltlf_ptr visit(const logic::LTLfPropTrue&);
+  logic::ltlf_ptr visit(const logic::LTLfPropFalse&);
+  logic::ltlf_ptr visit(const logic::LTLfAtom&);
+  logic::ltlf_ptr visit(const logic::LTLfNot&);
+  logic::ltlf_ptr visit(const logic::LTLfPropositionalNot&);
+  logic::ltlf_ptr visit(const logic::LTLfAnd&);
+  logic::ltlf_ptr visit(const logic::LTLfOr&);
+  logic::ltlf_ptr visit(const logic::LTLfImplies&);
+  logic::ltlf_ptr visit(const logic::LTLfEquivalent&);
+  logic::ltlf_ptr visit(const logic::LTLfXor&);
+  logic::ltlf_ptr visit(const logic::LTLfNext&);
+  logic::ltlf_ptr visit(const logic::LTLfWeakNext&);
+  logic::ltlf_ptr visit(const logic::LTLfUntil&);
+  logic::ltlf_ptr visit(const logic::LTLfRelease&);
+  logic::ltlf_ptr visit(const logic::LTLfEventually&);
+  logic::ltlf_ptr visit(const logic::LTLfAlways&);
 };
 
 logic::ltlf_ptr xnf(const logic::LTLfFormula& formula);
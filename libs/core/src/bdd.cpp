@@ -0,0 +1,383 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <cynthia/bdd.hpp>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+namespace cynthia {
+namespace core {
+
+static inline std::uint8_t group_bit(DdGroup group) {
+  return 1 << static_cast<int>(group);
+}
+
+BddManager::BddManager(size_t nb_state_variables, size_t nb_env_variables,
+                       size_t nb_system_variables, size_t cache_size)
+    : DdManager{nb_state_variables, nb_env_variables, nb_system_variables},
+      cache_(cache_size == 0 ? 1 : cache_size),
+      env_level_{static_cast<std::uint32_t>(nb_system_variables)},
+      state_level_{
+          static_cast<std::uint32_t>(nb_system_variables + nb_env_variables)} {
+  level_to_variable_.reserve(nb_variables());
+  for (auto group : {DdGroup::system, DdGroup::environment, DdGroup::state}) {
+    for (auto variable : get_variables(group)) {
+      level_to_variable_.push_back(variable);
+    }
+  }
+  variable_to_level_.resize(nb_variables());
+  for (std::uint32_t level = 0; level < level_to_variable_.size(); ++level) {
+    variable_to_level_[level_to_variable_[level]] = level;
+  }
+  // the terminal, below all the variables
+  Node terminal;
+  terminal.level = static_cast<std::uint32_t>(nb_variables());
+  nodes_.push_back(terminal);
+  resize_buckets_(1 << 10);
+}
+
+std::pair<BddManager::edge_t, BddManager::edge_t>
+BddManager::cofactors_(edge_t edge, std::uint32_t level) const {
+  const auto& node = nodes_[index_(edge)];
+  if (node.level != level) {
+    return {edge, edge};
+  }
+  edge_t complement = edge & 1;
+  return {node.low ^ complement, node.high ^ complement};
+}
+
+BddManager::edge_t BddManager::make_node_(std::uint32_t level, edge_t low,
+                                          edge_t high) {
+  if (low == high) {
+    return low;
+  }
+  // the high edge is never complemented: complement the node instead
+  edge_t complement = high & 1;
+  low ^= complement;
+  high ^= complement;
+  auto bucket = hash_(level, low, high) & (buckets_.size() - 1);
+  for (auto index = buckets_[bucket]; index != 0; index = nodes_[index].next) {
+    const auto& node = nodes_[index];
+    if (node.level == level and node.low == low and node.high == high) {
+      return (index << 1) | complement;
+    }
+  }
+
+  std::uint32_t index;
+  if (free_list_ != 0) {
+    index = free_list_;
+    free_list_ = nodes_[index].next;
+    --nb_free_nodes_;
+  } else {
+    if (nodes_.size() > (UINT32_MAX >> 1)) {
+      throw std::runtime_error("too many BDD nodes");
+    }
+    index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  }
+  auto group = level < env_level_     ? DdGroup::system
+               : level < state_level_ ? DdGroup::environment
+                                      : DdGroup::state;
+  auto& node = nodes_[index];
+  node.level = level;
+  node.low = low;
+  node.high = high;
+  node.ref_count = 0;
+  node.groups = groups_(low) | groups_(high) | group_bit(group);
+  node.serial = next_serial_++;
+  node.next = buckets_[bucket];
+  buckets_[bucket] = index;
+  if (size() > 2 * buckets_.size()) {
+    resize_buckets_(2 * buckets_.size());
+  }
+  return (index << 1) | complement;
+}
+
+void BddManager::insert_in_bucket_(std::uint32_t index) {
+  auto& node = nodes_[index];
+  auto bucket = hash_(node.level, node.low, node.high) & (buckets_.size() - 1);
+  node.next = buckets_[bucket];
+  buckets_[bucket] = index;
+}
+
+void BddManager::resize_buckets_(size_t nb_buckets) {
+  buckets_.assign(nb_buckets, 0);
+  for (std::uint32_t index = 1; index < nodes_.size(); ++index) {
+    if (nodes_[index].level != free_level) {
+      insert_in_bucket_(index);
+    }
+  }
+}
+
+BddManager::edge_t BddManager::conjoin_(edge_t first, edge_t second) {
+  if (first == false_edge or second == false_edge or first == (second ^ 1)) {
+    return false_edge;
+  }
+  if (first == true_edge) {
+    return second;
+  }
+  if (second == true_edge or first == second) {
+    return first;
+  }
+  if (first > second) {
+    std::swap(first, second);
+  }
+  auto& entry = cache_[hash_(0, first, second) % cache_.size()];
+  if (entry.valid and entry.first == first and entry.second == second) {
+    return entry.result;
+  }
+  auto level = std::min(level_(first), level_(second));
+  auto first_cofactors = cofactors_(first, level);
+  auto second_cofactors = cofactors_(second, level);
+  auto low = conjoin_(first_cofactors.first, second_cofactors.first);
+  auto high = conjoin_(first_cofactors.second, second_cofactors.second);
+  auto result = make_node_(level, low, high);
+  entry.first = first;
+  entry.second = second;
+  entry.result = result;
+  entry.valid = true;
+  return result;
+}
+
+BddManager::edge_t
+BddManager::exists_(edge_t edge, const std::vector<bool>& is_quantified,
+                    std::unordered_map<edge_t, edge_t>& cache) {
+  auto level = level_(edge);
+  if (level == nb_variables()) {
+    return edge;
+  }
+  auto cached = cache.find(edge);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+  auto cofactors = cofactors_(edge, level);
+  auto low = exists_(cofactors.first, is_quantified, cache);
+  auto high = exists_(cofactors.second, is_quantified, cache);
+  auto result = is_quantified[level] ? conjoin_(low ^ 1, high ^ 1) ^ 1
+                                     : make_node_(level, low, high);
+  cache.emplace(edge, result);
+  return result;
+}
+
+const std::map<BddManager::edge_t, BddManager::edge_t>&
+BddManager::cut_(edge_t edge, std::uint32_t boundary,
+                 std::unordered_map<edge_t, std::map<edge_t, edge_t>>& cache) {
+  auto cached = cache.find(edge);
+  if (cached != cache.end()) {
+    return cached->second;
+  }
+  // from each node below the boundary to the paths that reach it
+  std::map<edge_t, edge_t> partition;
+  auto level = level_(edge);
+  if (level >= boundary) {
+    partition.emplace(edge, true_edge);
+  } else {
+    auto add = [this, &partition](edge_t sub, edge_t prime) {
+      auto it = partition.find(sub);
+      if (it == partition.end()) {
+        partition.emplace(sub, prime);
+      } else {
+        it->second = conjoin_(it->second ^ 1, prime ^ 1) ^ 1;
+      }
+    };
+    auto cofactors = cofactors_(edge, level);
+    // the references stay valid when the cache grows
+    const auto& low_partition = cut_(cofactors.first, boundary, cache);
+    const auto& high_partition = cut_(cofactors.second, boundary, cache);
+    for (const auto& sub_and_prime : low_partition) {
+      add(sub_and_prime.first,
+          make_node_(level, sub_and_prime.second, false_edge));
+    }
+    for (const auto& sub_and_prime : high_partition) {
+      add(sub_and_prime.first,
+          make_node_(level, false_edge, sub_and_prime.second));
+    }
+  }
+  return cache.emplace(edge, std::move(partition)).first->second;
+}
+
+DdNode BddManager::literal(long literal) {
+  size_t variable = std::labs(literal) - 1;
+  if (literal == 0 or variable >= nb_variables()) {
+    throw std::invalid_argument("literal " + std::to_string(literal) +
+                                " out of range");
+  }
+  auto edge = make_node_(variable_to_level_[variable], false_edge, true_edge);
+  return to_node_(literal < 0 ? edge ^ 1 : edge);
+}
+
+DdNode BddManager::apply(DdNode first, DdNode second, DdOp op) {
+  if (op == DdOp::conjoin) {
+    return to_node_(conjoin_(to_edge_(first), to_edge_(second)));
+  }
+  return to_node_(conjoin_(to_edge_(first) ^ 1, to_edge_(second) ^ 1) ^ 1);
+}
+
+DdNode BddManager::exists(const std::vector<size_t>& variables, DdNode node) {
+  std::vector<bool> is_quantified(nb_variables(), false);
+  for (auto variable : variables) {
+    is_quantified[variable_to_level_.at(variable)] = true;
+  }
+  std::unordered_map<edge_t, edge_t> cache;
+  return to_node_(exists_(to_edge_(node), is_quantified, cache));
+}
+
+size_t BddManager::id(DdNode node) const {
+  auto edge = to_edge_(node);
+  return 2 * nodes_[index_(edge)].serial + (edge & 1);
+}
+
+long BddManager::literal_of(DdNode node) const {
+  auto edge = to_edge_(node);
+  const auto& bdd_node = nodes_[index_(edge)];
+  if (index_(edge) == 0 or bdd_node.low != false_edge or
+      bdd_node.high != true_edge) {
+    return 0;
+  }
+  auto literal = static_cast<long>(level_to_variable_[bdd_node.level]) + 1;
+  return is_complemented_(edge) ? -literal : literal;
+}
+
+DdRegion BddManager::region(DdNode node) const {
+  auto groups = groups_(to_edge_(node));
+  auto system = group_bit(DdGroup::system);
+  auto environment = group_bit(DdGroup::environment);
+  auto state = group_bit(DdGroup::state);
+  if (groups == 0) {
+    return DdRegion::constant;
+  }
+  if (groups & system) {
+    return groups == system ? DdRegion::system : DdRegion::root;
+  }
+  if (groups == environment) {
+    return DdRegion::environment;
+  }
+  return groups == state ? DdRegion::state : DdRegion::env_state;
+}
+
+dd_elements_t BddManager::elements(DdNode node) {
+  auto edge = to_edge_(node);
+  if (index_(edge) == 0) {
+    throw std::logic_error("a constant has no elements");
+  }
+  auto level = level_(edge);
+  auto cofactors = cofactors_(edge, level);
+  auto variable = make_node_(level, false_edge, true_edge);
+  return {{to_node_(variable), to_node_(cofactors.second)},
+          {to_node_(variable ^ 1), to_node_(cofactors.first)}};
+}
+
+dd_elements_t BddManager::decompose(DdNode node, DdGroup group) {
+  if (group == DdGroup::state) {
+    throw std::invalid_argument("cannot split a node at the state variables");
+  }
+  auto edge = to_edge_(node);
+  if (group == DdGroup::environment and
+      (groups_(edge) & group_bit(DdGroup::system))) {
+    throw std::logic_error("cannot split a node that depends on system "
+                           "variables at the environment variables");
+  }
+  auto boundary = group == DdGroup::system ? env_level_ : state_level_;
+  std::unordered_map<edge_t, std::map<edge_t, edge_t>> cache;
+  const auto& partition = cut_(edge, boundary, cache);
+  dd_elements_t elements;
+  elements.reserve(partition.size());
+  for (const auto& sub_and_prime : partition) {
+    elements.emplace_back(to_node_(sub_and_prime.second),
+                          to_node_(sub_and_prime.first));
+  }
+  return elements;
+}
+
+void BddManager::ref(DdNode node) {
+  auto index = index_(to_edge_(node));
+  if (index != 0) {
+    ++nodes_[index].ref_count;
+  }
+}
+
+void BddManager::deref(DdNode node) {
+  auto index = index_(to_edge_(node));
+  if (index != 0 and nodes_[index].ref_count > 0) {
+    --nodes_[index].ref_count;
+  }
+}
+
+size_t BddManager::garbage_collect() {
+  std::vector<bool> is_marked(nodes_.size(), false);
+  std::vector<std::uint32_t> stack;
+  is_marked[0] = true;
+  for (std::uint32_t index = 1; index < nodes_.size(); ++index) {
+    if (nodes_[index].level != free_level and nodes_[index].ref_count > 0) {
+      is_marked[index] = true;
+      stack.push_back(index);
+    }
+  }
+  while (!stack.empty()) {
+    const auto& node = nodes_[stack.back()];
+    stack.pop_back();
+    for (auto child : {index_(node.low), index_(node.high)}) {
+      if (!is_marked[child]) {
+        is_marked[child] = true;
+        stack.push_back(child);
+      }
+    }
+  }
+
+  size_t nb_freed_nodes = 0;
+  for (std::uint32_t index = 1; index < nodes_.size(); ++index) {
+    auto& node = nodes_[index];
+    if (node.level == free_level or is_marked[index]) {
+      continue;
+    }
+    node.level = free_level;
+    node.next = free_list_;
+    free_list_ = index;
+    ++nb_free_nodes_;
+    ++nb_freed_nodes;
+  }
+  if (nb_freed_nodes > 0) {
+    resize_buckets_(buckets_.size());
+    for (auto& entry : cache_) {
+      entry.valid = false;
+    }
+  }
+  size_after_last_collection_ = size();
+  return nb_freed_nodes;
+}
+
+size_t BddManager::node_size(DdNode node) const {
+  // the terminal is not counted
+  std::unordered_set<std::uint32_t> visited{0};
+  std::vector<std::uint32_t> stack{index_(to_edge_(node))};
+  size_t size = 0;
+  while (!stack.empty()) {
+    auto index = stack.back();
+    stack.pop_back();
+    if (!visited.insert(index).second) {
+      continue;
+    }
+    ++size;
+    stack.push_back(index_(nodes_[index].low));
+    stack.push_back(index_(nodes_[index].high));
+  }
+  return size;
+}
+
+} // namespace core
+} // namespace cynthia
@@ -21,10 +21,22 @@
 namespace cynthia {
 namespace core {
 
+size_t Closure::get_id(const logic::LTLfFormula& formula) const {
+  auto it = from_subformula_to_id.find(&formula);
+  if (it != from_subformula_to_id.end()) {
+    return it->second;
+  }
+  // slow path: the node was not built by the same context.
+  return get_id(formula.shared_from_this());
+}
 size_t Closure::get_id(const logic::ltlf_ptr& formula) const {
+  auto it = from_subformula_to_id.find(formula.get());
+  if (it != from_subformula_to_id.end()) {
+    return it->second;
+  }
   auto result = utils::binary_search_find_index(from_id_to_subformula, formula,
                                                 utils::Deref::Less());
-  if (result > from_id_to_subformula.size()) {
+  if (result < 0) {
     throw std::invalid_argument("formula not found");
   }
   return result;
@@ -36,6 +48,44 @@ const logic::ltlf_ptr& Closure::get_formula(size_t index) const {
   return from_id_to_subformula[index];
 }
 
+bool Closure::is_state_variable(const logic::LTLfFormula& formula) {
+  if (logic::is_a<logic::LTLfNext>(formula) or
+      logic::is_a<logic::LTLfWeakNext>(formula) or
+      logic::is_a<logic::LTLfTrue>(formula) or
+      logic::is_a<logic::LTLfFalse>(formula)) {
+    return true;
+  }
+  // end is G(ff), not_end is F(tt)
+  if (logic::is_a<logic::LTLfAlways>(formula)) {
+    const auto& arg = *dynamic_cast<const logic::LTLfAlways&>(formula).arg;
+    return logic::is_a<logic::LTLfFalse>(arg);
+  }
+  if (logic::is_a<logic::LTLfEventually>(formula)) {
+    const auto& arg = *dynamic_cast<const logic::LTLfEventually&>(formula).arg;
+    return logic::is_a<logic::LTLfTrue>(arg);
+  }
+  return false;
+}
+size_t Closure::get_state_id(const logic::LTLfFormula& formula) const {
+  auto it = from_subformula_to_state_id.find(&formula);
+  if (it != from_subformula_to_state_id.end()) {
+    return it->second;
+  }
+  auto result = utils::binary_search_find_index(from_state_id_to_subformula,
+                                                formula.shared_from_this(),
+                                                utils::Deref::Less());
+  if (result < 0) {
+    throw std::invalid_argument("formula is not a state variable");
+  }
+  return result;
+}
+const logic::ltlf_ptr& Closure::get_state_formula(size_t index) const {
+  if (index >= from_state_id_to_subformula.size()) {
+    throw std::invalid_argument("invalid index");
+  }
+  return from_state_id_to_subformula[index];
+}
+
 void ClosureVisitor::visit(const logic::LTLfTrue& formula) {
   insert_if_not_already_present_(formula);
 }
@@ -124,7 +174,28 @@ void ClosureVisitor::visit(const logic::LTLfAlways& formula) {
   apply_to_unary_op_(formula);
   apply(*formula.ctx().make_weak_next(formula.shared_from_this()));
 }
-void ClosureVisitor::apply(const logic::LTLfFormula& f) { f.accept(*this); }
+void ClosureVisitor::apply(const logic::LTLfFormula& f) {
+  // nested calls from the visit methods only queue the formula, which is
+  // visited by the outermost call: the depth of the formula does not
+  // translate into recursion depth.
+  pending_.push_back(f.shared_from_this());
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  try {
+    while (!pending_.empty()) {
+      auto formula = std::move(pending_.back());
+      pending_.pop_back();
+      formula->accept(*this);
+    }
+  } catch (...) {
+    pending_.clear();
+    running_ = false;
+    throw;
+  }
+  running_ = false;
+}
 Closure closure(const logic::LTLfFormula& f) {
   auto visitor = ClosureVisitor{};
   visitor.apply(f);
@@ -150,9 +221,28 @@ std::vector<logic::atom_ptr>::const_iterator Closure::end_atoms() const {
 
 Closure::Closure(const logic::set_ptr& formulas)
     : from_id_to_subformula(utils::vectify(formulas)) {
+  build_index_();
+  build_state_index_();
   find_atoms_();
 }
 
+void Closure::build_index_() {
+  from_subformula_to_id.reserve(from_id_to_subformula.size());
+  for (size_t i = 0; i < from_id_to_subformula.size(); ++i) {
+    from_subformula_to_id[from_id_to_subformula[i].get()] = i;
+  }
+}
+
+void Closure::build_state_index_() {
+  for (const auto& formula : from_id_to_subformula) {
+    if (is_state_variable(*formula)) {
+      from_subformula_to_state_id[formula.get()] =
+          from_state_id_to_subformula.size();
+      from_state_id_to_subformula.push_back(formula);
+    }
+  }
+}
+
 void Closure::find_atoms_() {
   for (const auto& formula : this->from_id_to_subformula) {
     if (logic::is_a<logic::LTLfAtom>(*formula)) {
@@ -15,18 +15,18 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cynthia/bdd.hpp>
 #include <cynthia/core.hpp>
 #include <cynthia/eval.hpp>
 #include <cynthia/logic/nnf.hpp>
 #include <cynthia/logic/print.hpp>
+#include <cynthia/logic/simplifier.hpp>
 #include <cynthia/one_step_realizability.hpp>
 #include <cynthia/one_step_unrealizability.hpp>
-#include <cynthia/sdd_to_formula.hpp>
-#include <cynthia/sddcpp.hpp>
-#include <cynthia/strip_next.hpp>
-#include <cynthia/to_sdd.hpp>
+#include <cynthia/to_dd.hpp>
 #include <cynthia/vtree.hpp>
 #include <cynthia/xnf.hpp>
+#include <queue>
 
 namespace cynthia {
 namespace core {
@@ -64,27 +64,61 @@ bool ForwardSynthesis::forward_synthesis_() {
     return false;
   }
 
-  context_.logger.info("Building the root SDD node...");
-  auto root_sdd_node = to_sdd(*context_.xnf_formula, context_);
-  auto sdd_formula_id = sdd_id(root_sdd_node);
+  context_.logger.info("Building the root node...");
+  auto root_node = to_dd(*context_.xnf_formula, context_);
+  auto root_id = context_.manager->id(root_node);
   context_.logger.info("Starting first system move...");
   auto strategy = system_move_(context_.xnf_formula, path);
-  bool result = strategy[sdd_formula_id] != sdd_manager_false(context_.manager);
+  bool result = strategy[root_id] != context_.dd_false();
   context_.logger.info("Explored states: {}",
                        context_.statistics_.nb_visited_nodes());
-  return result;
-}
-
-std::map<std::string, size_t> ForwardSynthesis::compute_prop_to_id_map(
-    const Closure& closure, const InputOutputPartition& partition) {
-  std::map<std::string, size_t> result;
-  size_t offset = closure.nb_formulas();
-  size_t i = offset;
-  for (const auto& p : partition.input_variables) {
-    result[p] = i++;
+  context_.logger.info("Decision diagram nodes: {}", context_.manager->size());
+  auto next_state_stats = context_.next_state_visitor.cache_stats();
+  auto xnf_stats = context_.xnf_visitor.cache_stats();
+  context_.logger.info("next state cache: {} hits, {} misses, {} entries",
+                       next_state_stats.hits, next_state_stats.misses,
+                       next_state_stats.size);
+  context_.logger.info("xnf cache: {} hits, {} misses, {} entries",
+                       xnf_stats.hits, xnf_stats.misses, xnf_stats.size);
+  auto to_formula_stats = context_.node_id_to_formula.stats();
+  context_.logger.info(
+      "node to formula cache: {} hits, {} misses, {} entries",
+      to_formula_stats.hits, to_formula_stats.misses, to_formula_stats.size);
+  auto to_node_stats = context_.formula_to_node.stats();
+  context_.logger.info(
+      "formula to node cache: {} hits, {} misses, {} entries",
+      to_node_stats.hits, to_node_stats.misses, to_node_stats.size);
+  if (context_.gc_policy.options().enabled) {
+    const auto& gc_stats = context_.gc_policy.statistics();
+    context_.logger.info("garbage collection: {} collections in {} checks, "
+                         "{} freed, {}ms total pause, {}ms max pause",
+                         gc_stats.nb_collections, gc_stats.nb_checks,
+                         gc_stats.freed_size, gc_stats.total_pause_ms,
+                         gc_stats.max_pause_ms);
   }
-  for (const auto& p : partition.output_variables) {
-    result[p] = i++;
+  if (!context_.sdd_manager) {
+    return result;
+  }
+  const auto& vtree_minimizer = context_.sdd_manager->vtree_minimizer();
+  if (vtree_minimizer.options().enabled) {
+    const auto& search_stats = vtree_minimizer.statistics();
+    context_.logger.info("vtree search: {} searches, live size {} -> {}, "
+                         "{}ms",
+                         search_stats.nb_searches,
+                         search_stats.live_size_before,
+                         search_stats.live_size_after,
+                         search_stats.total_time_ms);
+  }
+  // keep the vtree for the next solves, if it is new or it was improved
+  if (!context_.vtree_options.cache_directory.empty() and
+      (!context_.vtree_from_cache or
+       vtree_minimizer.statistics().nb_searches > 0)) {
+    auto cache = VtreeCache(context_.vtree_options.cache_directory);
+    if (!cache.save(context_.closure_, context_.partition,
+                    sdd_manager_vtree(context_.sdd_manager->get_manager()))) {
+      context_.logger.info("Could not write the vtree to the cache in {}",
+                           context_.vtree_options.cache_directory);
+    }
   }
   return result;
 }
@@ -92,43 +126,41 @@ std::map<std::string, size_t> ForwardSynthesis::compute_prop_to_id_map(
 strategy_t ForwardSynthesis::system_move_(const logic::ltlf_ptr& formula,
                                           Path& path) {
   strategy_t success_strategy, failure_strategy;
+  context_.at_safe_point();
   context_.indentation += 1;
-  auto sdd = SddNodeWrapper(to_sdd(*formula, context_), context_.manager);
-  auto sdd_formula_id = sdd.get_id();
-  context_.statistics_.visit_node(sdd_formula_id);
+  auto node = formula_to_node_(formula);
+  auto node_id = context_.manager->id(node);
+  context_.statistics_.visit_node(node_id);
 
-  success_strategy[sdd_formula_id] = sdd_manager_true(context_.manager);
-  failure_strategy[sdd_formula_id] = sdd_manager_false(context_.manager);
-  context_.print_search_debug("State {}", sdd_formula_id);
+  success_strategy[node_id] = context_.dd_true();
+  failure_strategy[node_id] = context_.dd_false();
+  context_.print_search_debug("State {}", node_id);
 
-  if (context_.discovered.find(sdd_formula_id) != context_.discovered.end()) {
+  if (context_.discovered.find(node_id) != context_.discovered.end()) {
     context_.indentation -= 1;
-    bool is_success = context_.discovered[sdd_formula_id];
+    bool is_success = context_.discovered[node_id];
     if (is_success) {
-      context_.print_search_debug("{} already discovered, success",
-                                  sdd_formula_id);
-      return strategy_t{
-          {sdd_formula_id, context_.winning_moves[sdd_formula_id]}};
+      context_.print_search_debug("{} already discovered, success", node_id);
+      return strategy_t{{node_id, context_.winning_moves[node_id]}};
     } else {
-      context_.print_search_debug("{} already discovered, failure",
-                                  sdd_formula_id);
+      context_.print_search_debug("{} already discovered, failure", node_id);
       return failure_strategy;
     }
   }
 
-  if (path.contains(sdd_formula_id)) {
+  if (path.contains(node_id)) {
     context_.print_search_debug("Loop detected for node {}, tagging the node",
-                                sdd_formula_id);
-    context_.loop_tags.insert(sdd_formula_id);
-    context_.discovered[sdd_formula_id] = false;
+                                node_id);
+    context_.loop_tags.insert(node_id);
+    context_.discovered[node_id] = false;
     context_.indentation -= 1;
     return failure_strategy;
   }
 
   if (eval(*formula)) {
-    context_.print_search_debug("{} accepting!", sdd_formula_id);
-    context_.discovered[sdd_formula_id] = true;
-    context_.winning_moves[sdd_formula_id] = sdd_manager_true(context_.manager);
+    context_.print_search_debug("{} accepting!", node_id);
+    context_.discovered[node_id] = true;
+    context_.winning_moves[node_id] = context_.dd_true();
     context_.indentation -= 1;
     return success_strategy;
   }
@@ -137,69 +169,65 @@ strategy_t ForwardSynthesis::system_move_(const logic::ltlf_ptr& formula,
       one_step_realizability(*formula, context_);
   if (one_step_realizability_result.second) {
     strategy_t strategy;
-    strategy[sdd_formula_id] = one_step_realizability_result.first;
-    context_.discovered[sdd_formula_id] = true;
-    context_.winning_moves[sdd_formula_id] =
-        one_step_realizability_result.first;
+    strategy[node_id] = one_step_realizability_result.first;
+    context_.discovered[node_id] = true;
+    context_.winning_moves[node_id] = one_step_realizability_result.first;
     context_.indentation -= 1;
     return strategy;
   }
   auto is_unrealizable = one_step_unrealizability(*formula, context_);
   if (!is_unrealizable) {
-    context_.discovered[sdd_formula_id] = false;
+    context_.discovered[node_id] = false;
     context_.indentation -= 1;
     return failure_strategy;
   }
 
-  path.push(sdd_formula_id);
-  if (sdd.get_type() == SddNodeType::STATE) {
+  path.push(node_id);
+  auto region = context_.manager->region(node);
+  if (region == DdRegion::constant or region == DdRegion::state) {
     // both system and env moves are irrelevant
-    auto system_move_str =
-        logic::to_string(*sdd_to_formula(sdd.get_raw(), context_));
-    context_.print_search_debug("system move (unique): {}", system_move_str);
-    auto new_strategy = env_move_(sdd, path);
+    if (context_.is_search_debug_enabled()) {
+      context_.print_search_debug(
+          "system move (unique): {}",
+          logic::to_string(*dd_to_formula(node, context_)));
+    }
+    auto new_strategy = env_move_(node, path);
     if (!new_strategy.empty()) {
       path.pop();
-      context_.discovered[sdd_formula_id] = true;
-      context_.winning_moves[sdd_formula_id] =
-          sdd_manager_true(context_.manager);
+      context_.discovered[node_id] = true;
+      context_.winning_moves[node_id] = context_.dd_true();
       context_.indentation -= 1;
       return success_strategy;
     }
-  } else if (sdd.get_type() == SddNodeType::ENV_STATE) {
-    // not at the vtree root; it means that system choice is irrelevant
-    // (but env has several choices)
+  } else if (node_type_(node) == NodeType::AND) {
+    // system choice is irrelevant (but env has several choices)
     context_.print_search_debug("system choice is irrelevant");
-    auto env_state_node = sdd;
-    auto new_strategy = env_move_(env_state_node, path);
+    auto new_strategy = env_move_(node, path);
     if (!new_strategy.empty()) {
       context_.print_search_debug("Any system move is a success from state {}!",
-                                  sdd_formula_id);
+                                  node_id);
       path.pop();
       // all system moves are OK, since it does not have control
-      context_.discovered[sdd_formula_id] = true;
-      context_.winning_moves[sdd_formula_id] =
-          sdd_manager_true(context_.manager);
+      context_.discovered[node_id] = true;
+      context_.winning_moves[node_id] = context_.dd_true();
       context_.indentation -= 1;
-      new_strategy[sdd_formula_id] = sdd_manager_true(context_.manager);
+      new_strategy[node_id] = context_.dd_true();
       return new_strategy;
     }
   } else { // is a decision node
-    auto child_it = sdd.begin();
-    auto children_end = sdd.end();
-
-    if (child_it == children_end) {
-      context_.print_search_debug("No children, {} is failure", sdd_formula_id);
+    auto children = decompose_(node, DdGroup::system);
+    if (children.empty()) {
+      context_.print_search_debug("No children, {} is failure", node_id);
       path.pop();
-      context_.discovered[sdd_formula_id] = false;
+      context_.discovered[node_id] = false;
       context_.indentation -= 1;
       return failure_strategy;
     }
 
     context_.print_search_debug("Processing {} system node's children nodes",
-                                sdd.nb_children());
-    std::vector<std::pair<SddNodeWrapper, SddNodeWrapper>> new_children;
-    new_children.reserve(sdd.nb_children());
+                                children.size());
+    std::vector<std::pair<DdRef, DdRef>> new_children;
+    new_children.reserve(children.size());
     // process all children, looking for OR-nodes
     // do the one-step-lookahead:
     // - if it is not an OR node, add to the new_children list so to be
@@ -209,101 +237,93 @@ strategy_t ForwardSynthesis::system_move_(const logic::ltlf_ptr& formula,
     //    continue
     //    - if one-step-realizability succeeds, return
     //    - if one-step-unrealizability succeeds, ignore and continue
-    for (; child_it != children_end; ++child_it) {
-      auto system_move = SddNodeWrapper(child_it.get_prime(), context_.manager);
-      auto env_state_node =
-          SddNodeWrapper(child_it.get_sub(), context_.manager);
-      if (env_state_node.get_type() == STATE) {
-        // OR->OR transition
-        auto formula_next_state = next_state_formula_(env_state_node.get_raw());
-        auto next_state = formula_to_sdd_(formula_next_state);
-        auto next_state_id = next_state.get_id();
-        add_transition_(sdd, system_move.get_raw(), next_state);
-        auto next_state_result_it =
-            context_.discovered.find(next_state.get_id());
-        if (next_state_result_it != context_.discovered.end()) {
-          auto next_state_is_success = next_state_result_it->second;
-          if (next_state_is_success) {
-            context_.print_search_debug(
-                "system look-ahead: next state {} already discovered, success",
-                next_state.get_id());
-            path.pop();
-            context_.indentation -= 1;
-            strategy_t strategy;
-            strategy[sdd_formula_id] = system_move.get_raw();
-            return strategy;
-          } else {
-            context_.print_search_debug(
-                "system look-ahead: next state {} already "
-                "discovered, failure, ignoring",
-                next_state.get_id());
-            continue;
-          }
-        }
-        auto one_step_realizability_result =
-            one_step_realizability(*formula_next_state, context_);
-        if (one_step_realizability_result.second) {
-          context_.print_search_debug("system look-ahead: one-step "
-                                      "realizability check was successful");
-          strategy_t strategy;
-          strategy[sdd_formula_id] = system_move.get_raw();
-          strategy[next_state_id] = one_step_realizability_result.first;
-          context_.discovered[next_state_id] = true;
-          context_.discovered[sdd_formula_id] = true;
-          context_.winning_moves[sdd_formula_id] = system_move.get_raw();
-          context_.winning_moves[next_state_id] =
-              one_step_realizability_result.first;
-          context_.indentation -= 1;
-          return strategy;
-        }
-        auto is_unrealizable =
-            one_step_unrealizability(*formula_next_state, context_);
-        if (!is_unrealizable) {
-          context_.print_search_debug("system look-ahead: one-step "
-                                      "unrealizability check was successful");
-          context_.discovered[next_state_id] = false;
-          continue;
-        }
-        context_.print_search_debug(
-            "system look-ahead: next state {} not discovered yet ",
-            next_state.get_id());
-        new_children.emplace_back(system_move, env_state_node);
-      } else {
+    for (const auto& child : children) {
+      auto system_move = child.first.get();
+      auto env_state_node = child.second.get();
+      if (node_type_(env_state_node) == NodeType::AND) {
         // one-step lookahead check inconclusive, need to take env action.
         // OR-AND transition.
-        assert(env_state_node.get_type() == ENV_STATE);
         context_.print_search_debug("system look-ahead: {} is not a state node",
-                                    env_state_node.get_id());
-        new_children.emplace_back(system_move, env_state_node);
+                                    context_.manager->id(env_state_node));
+        new_children.push_back(child);
+        continue;
+      }
+      // OR->OR transition
+      auto formula_next_state = next_state_formula_(env_state_node);
+      auto next_state = formula_to_node_(formula_next_state);
+      auto next_state_id = context_.manager->id(next_state);
+      add_transition_(node, system_move, next_state);
+      auto next_state_result_it = context_.discovered.find(next_state_id);
+      if (next_state_result_it != context_.discovered.end()) {
+        if (next_state_result_it->second) {
+          context_.print_search_debug(
+              "system look-ahead: next state {} already discovered, success",
+              next_state_id);
+          path.pop();
+          context_.indentation -= 1;
+          strategy_t strategy;
+          strategy[node_id] = child.first;
+          return strategy;
+        }
+        context_.print_search_debug("system look-ahead: next state {} already "
+                                    "discovered, failure, ignoring",
+                                    next_state_id);
+        continue;
       }
+      auto next_realizability_result =
+          one_step_realizability(*formula_next_state, context_);
+      if (next_realizability_result.second) {
+        context_.print_search_debug("system look-ahead: one-step "
+                                    "realizability check was successful");
+        strategy_t strategy;
+        strategy[node_id] = child.first;
+        strategy[next_state_id] = next_realizability_result.first;
+        context_.discovered[next_state_id] = true;
+        context_.discovered[node_id] = true;
+        context_.winning_moves[node_id] = child.first;
+        context_.winning_moves[next_state_id] =
+            next_realizability_result.first;
+        context_.indentation -= 1;
+        return strategy;
+      }
+      if (!one_step_unrealizability(*formula_next_state, context_)) {
+        context_.print_search_debug("system look-ahead: one-step "
+                                    "unrealizability check was successful");
+        context_.discovered[next_state_id] = false;
+        continue;
+      }
+      context_.print_search_debug(
+          "system look-ahead: next state {} not discovered yet ",
+          next_state_id);
+      new_children.push_back(child);
     }
 
-    // process the new_children list of AND nodes, populated in the previous
-    // loop.
+    // process the AND nodes and the undecided OR nodes
     for (const auto& pair : new_children) {
-      auto system_move = pair.first;
-      auto env_state_node = pair.second;
-      auto system_move_str =
-          logic::to_string(*sdd_to_formula(system_move.get_raw(), context_));
+      auto system_move = pair.first.get();
+      auto env_state_node = pair.second.get();
+      std::string system_move_str;
+      if (context_.is_search_debug_enabled()) {
+        system_move_str =
+            logic::to_string(*dd_to_formula(system_move, context_));
+      }
       context_.print_search_debug("checking system move: {}", system_move_str);
-      ++child_it;
-      if (system_move.is_false())
+      if (context_.manager->is_false(system_move))
         continue;
       auto new_strategy = env_move_(env_state_node, path);
       if (!new_strategy.empty()) {
         context_.print_search_debug(
-            "System move {} from state {} is successful", sdd_formula_id,
-            system_move_str);
+            "System move {} from state {} is successful", system_move_str,
+            node_id);
         path.pop();
-        new_strategy[sdd_formula_id] = system_move.get_raw();
-        context_.discovered[sdd_formula_id] = true;
-        context_.winning_moves[sdd_formula_id] = system_move.get_raw();
-        if (context_.loop_tags.find(sdd_formula_id) !=
-            context_.loop_tags.end()) {
+        new_strategy[node_id] = pair.first;
+        context_.discovered[node_id] = true;
+        context_.winning_moves[node_id] = pair.first;
+        if (context_.loop_tags.find(node_id) != context_.loop_tags.end()) {
           context_.print_search_debug("trigger backward search to update "
                                       "success tag of predecessors of {}",
-                                      sdd_formula_id);
-          backprop_success(sdd, new_strategy);
+                                      node_id);
+          backprop_success(node, new_strategy);
         }
         context_.indentation -= 1;
         return new_strategy;
@@ -311,297 +331,321 @@ strategy_t ForwardSynthesis::system_move_(const logic::ltlf_ptr& formula,
     }
   }
 
-  context_.print_search_debug("State {} is failure", sdd_formula_id);
+  context_.print_search_debug("State {} is failure", node_id);
   path.pop();
-  context_.discovered[sdd_formula_id] = false;
+  context_.discovered[node_id] = false;
   context_.indentation -= 1;
   return failure_strategy;
 }
 
-strategy_t ForwardSynthesis::env_move_(SddNodeWrapper& wrapper, Path& path) {
+strategy_t ForwardSynthesis::env_move_(DdNode node, Path& path) {
   context_.indentation += 1;
-  if (wrapper.get_type() == SddNodeType::STATE) {
+  if (node_type_(node) == NodeType::OR) {
     // env move is irrelevant
-    auto formula_next_state = next_state_formula_(wrapper.get_raw());
-    auto sdd_next_state = formula_to_sdd_(formula_next_state);
-    auto sdd_next_state_id = sdd_next_state.get_id();
+    auto formula_next_state = next_state_formula_(node);
+    auto next_state = formula_to_node_(formula_next_state);
+    auto next_state_id = context_.manager->id(next_state);
     // add OR->? transition
-    add_transition_(wrapper, sdd_manager_true(context_.manager),
-                    sdd_next_state);
+    add_transition_(node, context_.manager->dd_true(), next_state);
     context_.print_search_debug("env move forced to next state {}",
-                                sdd_next_state_id);
+                                next_state_id);
     auto strategy = system_move_(formula_next_state, path);
     context_.indentation -= 1;
-    if (strategy[sdd_next_state_id] == sdd_manager_false(context_.manager))
+    if (strategy[next_state_id] == context_.dd_false())
       return strategy_t{};
     return strategy;
-  } else {
-    // env move is relevant, checking all moves and successors
-    assert(wrapper.get_type() == ENV_STATE);
-    auto child_it = wrapper.begin();
-    auto children_end = wrapper.end();
-    context_.print_search_debug("Processing {} env node's children nodes",
-                                wrapper.nb_children());
-    std::vector<std::pair<SddNodeWrapper, SddNodeWrapper>> new_children;
-    new_children.reserve(wrapper.nb_children());
-    // process all children, looking for OR-successors
-    // do the one-step-lookahead:
-    //  - if already discovered: if success, return, otherwise must be visited
-    //  later
-    //  - if one-step-realizability succeeds, ignore and continue
-    //  - if one-step-unrealizability succeeds, return failure
-    for (; child_it != children_end; ++child_it) {
-      bool ignore = false;
-      auto env_node = SddNodeWrapper(child_it.get_prime(), context_.manager);
-      auto state_node = SddNodeWrapper(child_it.get_sub(), context_.manager);
-      assert(state_node.get_type() == STATE);
-      auto formula_next_state = next_state_formula_(state_node.get_raw());
-      auto sdd_next_state = formula_to_sdd_(formula_next_state);
-      // add AND->? transition
-      add_transition_(wrapper, env_node.get_raw(), sdd_next_state);
-      auto next_state_id = sdd_next_state.get_id();
-      auto next_state_result_it = context_.discovered.find(next_state_id);
-      if (next_state_result_it != context_.discovered.end()) {
-        auto next_state_is_success = next_state_result_it->second;
-        if (next_state_is_success) {
-          context_.print_search_debug("env look-ahead: next state {} already "
-                                      "discovered, success, ignoring",
-                                      next_state_id);
-          ignore = true;
-        }
-        if (!next_state_is_success) {
-          context_.print_search_debug(
-              "env look-ahead: next state {} already discovered, failure",
-              next_state_id);
-          context_.indentation -= 1;
-          return strategy_t{};
-        }
-      }
-      auto is_unrealizable =
-          one_step_unrealizability(*formula_next_state, context_);
-      if (!is_unrealizable) {
-        context_.print_search_debug("env look-ahead: one-step "
-                                    "unrealizability check was successful");
-        context_.discovered[next_state_id] = false;
+  }
+
+  // env move is relevant, checking all moves and successors
+  auto children = decompose_(node, DdGroup::environment);
+  context_.print_search_debug("Processing {} env node's children nodes",
+                              children.size());
+  std::vector<std::pair<DdRef, DdRef>> new_children;
+  new_children.reserve(children.size());
+  // process all children, looking for OR-successors
+  // do the one-step-lookahead:
+  //  - if already discovered: if success, return, otherwise must be visited
+  //  later
+  //  - if one-step-realizability succeeds, ignore and continue
+  //  - if one-step-unrealizability succeeds, return failure
+  for (const auto& child : children) {
+    bool ignore = false;
+    auto env_node = child.first.get();
+    auto state_node = child.second.get();
+    auto formula_next_state = next_state_formula_(state_node);
+    auto next_state = formula_to_node_(formula_next_state);
+    // add AND->? transition
+    add_transition_(node, env_node, next_state);
+    auto next_state_id = context_.manager->id(next_state);
+    auto next_state_result_it = context_.discovered.find(next_state_id);
+    if (next_state_result_it != context_.discovered.end()) {
+      if (next_state_result_it->second) {
+        context_.print_search_debug("env look-ahead: next state {} already "
+                                    "discovered, success, ignoring",
+                                    next_state_id);
+        ignore = true;
+      } else {
+        context_.print_search_debug(
+            "env look-ahead: next state {} already discovered, failure",
+            next_state_id);
         context_.indentation -= 1;
         return strategy_t{};
       }
-      auto one_step_realizability_result =
-          one_step_realizability(*formula_next_state, context_);
-      if (one_step_realizability_result.second) {
-        context_.print_search_debug("env look-ahead: one-step "
-                                    "realizability check was successful");
-        context_.discovered[next_state_id] = true;
-        context_.winning_moves[next_state_id] =
-            one_step_realizability_result.first;
-        continue;
-      }
-      if (!ignore) {
-        // we don't know, need to take env action
-        context_.print_search_debug(
-            "env look-ahead: next state {} not discovered yet",
-            state_node.get_id());
-        new_children.emplace_back(env_node, state_node);
-      }
     }
-
-    if (new_children.empty()) {
-      // take any successor, it will be a win
-      context_.print_search_debug(
-          "env look-ahead: taking any env action, system wins");
-      auto formula_next_state = next_state_formula_(wrapper.begin().get_sub());
+    if (!one_step_unrealizability(*formula_next_state, context_)) {
+      context_.print_search_debug("env look-ahead: one-step "
+                                  "unrealizability check was successful");
+      context_.discovered[next_state_id] = false;
       context_.indentation -= 1;
-      return system_move_(formula_next_state, path);
+      return strategy_t{};
     }
-    strategy_t final_strategy;
-
-    // process the new_children list, populated in the previous loop.
-    for (const auto& pair : new_children) {
-      auto env_move = pair.first;
-      auto state_node = pair.second;
-      auto env_action = sdd_to_formula(env_move.get_raw(), context_);
-      auto env_action_str = logic::to_string(*env_action);
-      auto formula_next_state = next_state_formula_(state_node.get_raw());
-      auto sdd_next_state = formula_to_sdd_(formula_next_state);
-      auto sdd_next_state_id = sdd_next_state.get_id();
-      context_.print_search_debug("env move: {}", env_action_str);
-      auto strategy = system_move_(formula_next_state, path);
-      if (strategy[sdd_next_state_id] == sdd_manager_false(context_.manager)) {
-        context_.indentation -= 1;
-        return strategy_t{};
-      }
-      final_strategy.insert(strategy.begin(), strategy.end());
+    auto next_realizability_result =
+        one_step_realizability(*formula_next_state, context_);
+    if (next_realizability_result.second) {
+      context_.print_search_debug("env look-ahead: one-step "
+                                  "realizability check was successful");
+      context_.discovered[next_state_id] = true;
+      context_.winning_moves[next_state_id] = next_realizability_result.first;
+      continue;
+    }
+    if (!ignore) {
+      // we don't know, need to take env action
+      context_.print_search_debug(
+          "env look-ahead: next state {} not discovered yet", next_state_id);
+      new_children.push_back(child);
     }
+  }
+
+  if (new_children.empty()) {
+    // take any successor, it will be a win
+    context_.print_search_debug(
+        "env look-ahead: taking any env action, system wins");
+    auto formula_next_state =
+        next_state_formula_(children.front().second.get());
     context_.indentation -= 1;
-    return final_strategy;
+    return system_move_(formula_next_state, path);
+  }
+  strategy_t final_strategy;
+
+  // process the new_children list, populated in the previous loop.
+  for (const auto& pair : new_children) {
+    std::string env_action_str;
+    if (context_.is_search_debug_enabled()) {
+      env_action_str =
+          logic::to_string(*dd_to_formula(pair.first.get(), context_));
+    }
+    auto formula_next_state = next_state_formula_(pair.second.get());
+    auto next_state_id =
+        context_.manager->id(formula_to_node_(formula_next_state));
+    context_.print_search_debug("env move: {}", env_action_str);
+    auto strategy = system_move_(formula_next_state, path);
+    if (strategy[next_state_id] == context_.dd_false()) {
+      context_.indentation -= 1;
+      return strategy_t{};
+    }
+    final_strategy.insert(strategy.begin(), strategy.end());
   }
+  context_.indentation -= 1;
+  return final_strategy;
 }
 
-logic::ltlf_ptr ForwardSynthesis::next_state_formula_(SddNode* sdd_ptr) {
-  auto sdd_formula = sdd_to_formula(sdd_ptr, context_);
-  auto next_state_formula = xnf(*strip_next(*sdd_formula));
-  return next_state_formula;
+logic::ltlf_ptr ForwardSynthesis::next_state_formula_(DdNode node) {
+  auto formula = dd_to_formula(node, context_);
+  return context_.next_state_visitor.apply(*formula);
 }
-SddNodeWrapper
-ForwardSynthesis::formula_to_sdd_(const logic::ltlf_ptr& formula) {
-  auto wrapper = SddNodeWrapper(to_sdd(*formula, context_), context_.manager);
-  return wrapper;
+
+DdNode ForwardSynthesis::formula_to_node_(const logic::ltlf_ptr& formula) {
+  auto node = to_dd(*formula, context_);
+  context_.state_nodes.try_emplace(context_.manager->id(node),
+                                   context_.make_ref(node));
+  return node;
 }
-SddNodeWrapper ForwardSynthesis::next_state_(const SddNodeWrapper& wrapper) {
-  auto next_state_formula = next_state_formula_(wrapper.get_raw());
-  auto sdd_next_state = formula_to_sdd_(next_state_formula);
-  return sdd_next_state;
+
+std::vector<std::pair<DdRef, DdRef>>
+ForwardSynthesis::decompose_(DdNode node, DdGroup group) {
+  auto elements = context_.manager->decompose(node, group);
+  std::vector<std::pair<DdRef, DdRef>> result;
+  result.reserve(elements.size());
+  for (const auto& element : elements) {
+    result.emplace_back(context_.make_ref(element.first),
+                        context_.make_ref(element.second));
+  }
+  return result;
 }
 
-void ForwardSynthesis::backprop_success(SddNodeWrapper& node,
-                                        strategy_t& strategy) {
-  auto start_node = Node{node.get_id(), node_type_from_sdd_type_(node)};
+void ForwardSynthesis::backprop_success(DdNode node, strategy_t& strategy) {
+  auto start_node = Node{context_.manager->id(node), node_type_(node)};
   std::queue<Node> queue;
   queue.push(start_node);
-  Node current_node{};
   while (!queue.empty()) {
-    current_node = queue.front();
+    auto current_node = queue.front();
+    queue.pop();
     auto all_predecessors = context_.graph.get_predecessors(current_node);
     for (const auto& predecessors_by_action : all_predecessors) {
       auto action = predecessors_by_action.first;
-      auto predecessors = predecessors_by_action.second;
-      for (const auto& predecessor : predecessors) {
+      for (const auto& predecessor : predecessors_by_action.second) {
         if (predecessor.type == NodeType::OR) {
           context_.discovered[predecessor.id] = true;
           strategy[predecessor.id] = context_.graph.get_action_by_id(action);
           queue.push(predecessor);
-        } else { // if (predecessor.type == NodeType::AND) {
-          // TODO check: not all children of the AND node might have been added
-          // to the subgraph.
-          auto children_by_action = context_.graph.get_successors(predecessor);
-          if (std::all_of(
-                  children_by_action.begin(), children_by_action.end(),
-                  [this](const std::pair<size_t, Node>& action_and_child) {
-                    auto is_discovered =
-                        context_.discovered.find(action_and_child.second.id);
-                    return is_discovered == context_.discovered.end() and
-                           is_discovered->second;
-                  })) {
-            context_.discovered[predecessor.id] = true;
-            queue.push(predecessor);
-          }
+          continue;
+        }
+        // an AND node succeeds when all its known successors do
+        auto children_by_action = context_.graph.get_successors(predecessor);
+        if (std::all_of(
+                children_by_action.begin(), children_by_action.end(),
+                [this](const std::pair<size_t, Node>& action_and_child) {
+                  auto is_discovered =
+                      context_.discovered.find(action_and_child.second.id);
+                  return is_discovered != context_.discovered.end() and
+                         is_discovered->second;
+                })) {
+          context_.discovered[predecessor.id] = true;
+          queue.push(predecessor);
         }
       }
     }
-    queue.pop();
   }
 }
 
+NodeType ForwardSynthesis::node_type_(DdNode node) const {
+  auto region = context_.manager->region(node);
+  if (region == DdRegion::env_state or region == DdRegion::environment) {
+    return AND;
+  }
+  return OR;
+}
+
+void ForwardSynthesis::add_transition_(DdNode start, DdNode move_node,
+                                       DdNode end) {
+  auto start_node = Node{context_.manager->id(start), node_type_(start)};
+  auto end_node = Node{context_.manager->id(end), node_type_(end)};
+  context_.print_search_debug("Adding transition ({}, {}, {})",
+                              start_node.to_string(),
+                              std::to_string(context_.manager->id(move_node)),
+                              end_node.to_string());
+  context_.graph.add_transition(start_node, context_.make_ref(move_node),
+                                end_node);
+}
+
 ForwardSynthesis::Context::Context(const logic::ltlf_ptr& formula,
                                    const InputOutputPartition& partition,
-                                   bool use_gc, float gc_threshold)
-    : logger{"cynthia"}, formula{formula}, partition{partition}, use_gc{use_gc},
-      gc_threshold{gc_threshold}, ast_manager{&formula->ctx()} {
+                                   Backend backend,
+                                   const GcOptions& gc_options,
+                                   const logic::SimplifierOptions&
+                                       simplifier_options,
+                                   const VtreeSearchOptions&
+                                       vtree_search_options,
+                                   const VtreeOptions& vtree_options)
+    : formula{formula}, ast_manager{&formula->ctx()}, partition{partition},
+      vtree_options{vtree_options}, logger{"cynthia"}, gc_policy{gc_options} {
   nnf_formula = logic::to_nnf(*formula);
-  xnf_formula = xnf(*nnf_formula);
+  // the closure sets the number of state variables, so simplify the
+  // formula before computing it
+  size_t closure_size_before = 0;
+  bool report_closure_size = false;
+  if (simplifier_options.any()) {
+    auto simplified_formula =
+        logic::simplify_formula(*nnf_formula, simplifier_options);
+    if (simplified_formula != nnf_formula) {
+      // the closure of the unsimplified formula is only needed to report
+      // the effect of the simplification
+      if (logger.should_log(utils::LogLevel::debug)) {
+        // a separate visitor, so that the unsimplified subformulas do not
+        // stay in the cache of xnf_visitor
+        auto visitor = XnfVisitor{};
+        closure_size_before =
+            closure(*visitor.apply(*nnf_formula)).nb_formulas();
+        report_closure_size = true;
+      }
+      nnf_formula = simplified_formula;
+    }
+  }
+  xnf_formula = xnf_visitor.apply(*nnf_formula);
   Closure closure_object = closure(*xnf_formula);
   closure_ = closure_object;
-  auto builder = VTreeBuilder(closure_, partition);
-  vtree_ = builder.get_vtree();
-  manager = sdd_manager_new(vtree_);
-  prop_to_id = compute_prop_to_id_map(closure_, partition);
+  if (report_closure_size) {
+    logger.debug("Closure size: {} before simplification, {} after",
+                 closure_size_before, closure_.nb_formulas());
+  }
+  logger.info("State variables: {} of {} closure formulas",
+              closure_.nb_state_variables(), closure_.nb_formulas());
+  initialize_manager_(backend, vtree_search_options);
+  env_variables = manager->get_variables(DdGroup::environment);
+  initialize_atoms_();
   statistics_ = Statistics();
-  initialie_maps_();
+  nb_formulas_after_collection_ = ast_manager->nb_nodes();
 }
 
-logic::ltlf_ptr ForwardSynthesis::Context::get_formula(size_t index) const {
-  if (index < closure_.nb_formulas()) {
-    return closure_.get_formula(index);
+void ForwardSynthesis::Context::release_formulas_() {
+  if (xnf_visitor.cache_stats().size + next_state_visitor.cache_stats().size >
+      max_formula_cache_size) {
+    logger.debug("Releasing the xnf and next state caches");
+    next_state_visitor.clear_cache();
+    xnf_visitor.clear_cache();
   }
-  index -= closure_.nb_formulas();
-  if (index < partition.input_variables.size()) {
-    return ast_manager->make_atom(partition.input_variables[index]);
+  if (ast_manager->nb_nodes() < 2 * nb_formulas_after_collection_) {
+    return;
   }
-  index -= partition.input_variables.size();
-  return ast_manager->make_atom(partition.output_variables[index]);
+  auto nb_freed_formulas = ast_manager->collect_garbage();
+  nb_formulas_after_collection_ = ast_manager->nb_nodes();
+  logger.debug("Freed {} formula nodes, {} still interned", nb_freed_formulas,
+               nb_formulas_after_collection_);
 }
 
-void ForwardSynthesis::Context::call_gc_vtree() const {
-  if (use_gc) {
-    auto before_live = sdd_manager_live_size(manager);
-    auto before_dead = sdd_manager_dead_size(manager);
-    int result = sdd_manager_garbage_collect_if(gc_threshold, manager);
-    if (result) {
-      auto after_live = sdd_manager_live_size(manager);
-      auto after_dead = sdd_manager_dead_size(manager);
-      print_search_debug("vtree garbage collection with threshold {} completed",
-                         gc_threshold);
-      print_search_debug("== before garbage collection:");
-      print_search_debug("  live sdd size = {}", before_live);
-      print_search_debug("  dead sdd size = {}", before_dead);
-      print_search_debug("== after garbage collection:");
-      print_search_debug("  live sdd size = {}", after_live);
-      print_search_debug("  dead sdd size = {}", after_dead);
-    }
+void ForwardSynthesis::Context::initialize_manager_(
+    Backend backend, const VtreeSearchOptions& vtree_search_options) {
+  auto nb_state_variables = closure_.nb_state_variables();
+  auto nb_env_variables = partition.input_variables.size();
+  auto nb_system_variables = partition.output_variables.size();
+  if (backend == Backend::bdd) {
+    manager = std::make_unique<BddManager>(
+        nb_state_variables, nb_env_variables, nb_system_variables);
+    return;
   }
-}
-
-void ForwardSynthesis::Context::initialie_maps_() {
-  const auto nb_variables = closure_.nb_formulas() + closure_.nb_atoms();
-  controllable_map =
-      std::vector<int>(closure_.nb_formulas() + closure_.nb_atoms());
-  uncontrollable_map =
-      std::vector<int>(closure_.nb_formulas() + closure_.nb_atoms());
-
-  auto controllable_offset = closure_.nb_formulas();
-  auto uncontrollable_offset =
-      closure_.nb_formulas() + partition.input_variables.size();
-  for (int i = 0; i < nb_variables; ++i) {
-    if (i < controllable_offset) {
-      controllable_map[i] = 0;
-      uncontrollable_map[i] = 0;
-    } else if (i >= controllable_offset and i < uncontrollable_offset) {
-      controllable_map[i] = 1;
-      uncontrollable_map[i] = 0;
-    } else {
-      // uncontrollable
-      controllable_map[i] = 0;
-      uncontrollable_map[i] = 1;
+  Vtree* vtree = nullptr;
+  if (!vtree_options.cache_directory.empty()) {
+    vtree = VtreeCache(vtree_options.cache_directory).load(closure_, partition);
+    vtree_from_cache = vtree != nullptr;
+    if (vtree_from_cache) {
+      logger.info("Vtree read from the cache");
     }
   }
+  if (!vtree) {
+    auto builder =
+        VTreeBuilder(closure_, partition, vtree_options, xnf_formula);
+    vtree = builder.get_vtree();
+  }
+  auto sdd_dd_manager = std::make_unique<SddDdManager>(
+      nb_state_variables, nb_env_variables, nb_system_variables, vtree,
+      vtree_search_options);
+  sdd_manager = sdd_dd_manager.get();
+  manager = std::move(sdd_dd_manager);
 }
 
-NodeType
-ForwardSynthesis::node_type_from_sdd_type_(const SddNodeWrapper& wrapper) {
-  auto sdd_type = wrapper.get_type();
-  //  UNDEFINED = 0,
-  //  STATE = 1,
-  //  ENV = 2,
-  //  ENV_STATE = 3,
-  //  SYSTEM = 4,
-  //  SYSTEM_STATE = 5,
-  //  SYSTEM_ENV = 6,
-  //  SYSTEM_ENV_STATE = 7,
-  assert(sdd_type != UNDEFINED);
-  assert(sdd_type != ENV);
-  assert(sdd_type != SYSTEM);
-  assert(sdd_type != SYSTEM_ENV);
-  if (sdd_type == ENV_STATE) {
-    return AND;
+logic::ltlf_ptr ForwardSynthesis::Context::get_formula(size_t index) const {
+  if (index < closure_.nb_state_variables()) {
+    return closure_.get_state_formula(index);
   }
-  // sdd_type == SYSTEM_STATE || sdd_type == SYSTEM_ENV_STATE || sdd_type ==
-  // STATE
-  return OR;
+  return partition_atoms[index - closure_.nb_state_variables()];
 }
 
-void ForwardSynthesis::add_transition_(const SddNodeWrapper& start,
-                                       SddNode* move_node,
-                                       const SddNodeWrapper& end) {
-  auto start_state_type = node_type_from_sdd_type_(start);
-  auto end_state_type = node_type_from_sdd_type_(end);
-
-  auto start_node = Node{start.get_id(), start_state_type};
-  auto end_node = Node{end.get_id(), end_state_type};
-
-  context_.print_search_debug(
-      "Adding transition ({}, {}, {})", start_node.to_string(),
-      std::to_string(sdd_id(move_node)), end_node.to_string());
-  context_.graph.add_transition(start_node, move_node, end_node);
+void ForwardSynthesis::Context::initialize_atoms_() {
+  partition_atoms.reserve(partition.input_variables.size() +
+                          partition.output_variables.size());
+  for (const auto& p : partition.input_variables) {
+    partition_atoms.push_back(ast_manager->make_atom(p));
+  }
+  for (const auto& p : partition.output_variables) {
+    partition_atoms.push_back(ast_manager->make_atom(p));
+  }
+  symbol_to_id = std::vector<size_t>(ast_manager->nb_symbols(), no_id);
+  size_t offset = closure_.nb_state_variables();
+  for (size_t i = 0; i < partition_atoms.size(); ++i) {
+    const auto& atom =
+        dynamic_cast<const logic::LTLfAtom&>(*partition_atoms[i]);
+    symbol_to_id[atom.symbol_id] = offset + i;
+  }
 }
 
 } // namespace core
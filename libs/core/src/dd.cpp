@@ -0,0 +1,55 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cynthia/dd.hpp>
+#include <stdexcept>
+
+namespace cynthia {
+namespace core {
+
+DdGroup DdManager::get_group(size_t variable) const {
+  if (variable < nb_state_variables_) {
+    return DdGroup::state;
+  }
+  if (variable < nb_state_variables_ + nb_env_variables_) {
+    return DdGroup::environment;
+  }
+  if (variable < nb_variables()) {
+    return DdGroup::system;
+  }
+  throw std::invalid_argument("variable " + std::to_string(variable) +
+                              " out of range");
+}
+
+std::vector<size_t> DdManager::get_variables(DdGroup group) const {
+  size_t begin = 0, end = nb_state_variables_;
+  if (group == DdGroup::environment) {
+    begin = nb_state_variables_;
+    end = begin + nb_env_variables_;
+  } else if (group == DdGroup::system) {
+    begin = nb_state_variables_ + nb_env_variables_;
+    end = nb_variables();
+  }
+  std::vector<size_t> variables;
+  variables.reserve(end - begin);
+  for (size_t variable = begin; variable < end; ++variable) {
+    variables.push_back(variable);
+  }
+  return variables;
+}
+
+} // namespace core
+} // namespace cynthia
@@ -22,53 +22,47 @@
 namespace cynthia {
 namespace core {
 
-void EvalVisitor::visit(const logic::LTLfTrue& formula) { result = true; }
-void EvalVisitor::visit(const logic::LTLfFalse& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfPropTrue& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfPropFalse& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfAtom& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfNot& formula) {
+bool EvalVisitor::visit(const logic::LTLfTrue& formula) { return true; }
+bool EvalVisitor::visit(const logic::LTLfFalse& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfPropTrue& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfPropFalse& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfAtom& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfNot& formula) {
   logic::throw_expected_nnf();
 }
-void EvalVisitor::visit(const logic::LTLfPropositionalNot& formula) {
-  result = false;
+bool EvalVisitor::visit(const logic::LTLfPropositionalNot& formula) {
+  return false;
 }
-void EvalVisitor::visit(const logic::LTLfAnd& formula) {
-  result =
-      std::all_of(formula.args.begin(), formula.args.end(),
-                  [this](const logic::ltlf_ptr& arg) { return apply(*arg); });
+bool EvalVisitor::visit(const logic::LTLfAnd& formula) {
+  return std::all_of(
+      formula.args.begin(), formula.args.end(),
+      [this](const logic::ltlf_ptr& arg) { return apply(*arg); });
 }
-void EvalVisitor::visit(const logic::LTLfOr& formula) {
-  result =
-      std::any_of(formula.args.begin(), formula.args.end(),
-                  [this](const logic::ltlf_ptr& arg) { return apply(*arg); });
+bool EvalVisitor::visit(const logic::LTLfOr& formula) {
+  return std::any_of(
+      formula.args.begin(), formula.args.end(),
+      [this](const logic::ltlf_ptr& arg) { return apply(*arg); });
 }
-void EvalVisitor::visit(const logic::LTLfImplies& formula) {
-  result = apply(*simplify(formula));
+bool EvalVisitor::visit(const logic::LTLfImplies& formula) {
+  return apply(*simplify(formula));
 }
-void EvalVisitor::visit(const logic::LTLfEquivalent& formula) {
-  result = apply(*simplify(formula));
+bool EvalVisitor::visit(const logic::LTLfEquivalent& formula) {
+  return apply(*simplify(formula));
 }
-void EvalVisitor::visit(const logic::LTLfXor& formula) {
-  result = apply(*simplify(formula));
+bool EvalVisitor::visit(const logic::LTLfXor& formula) {
+  return apply(*simplify(formula));
 }
-void EvalVisitor::visit(const logic::LTLfNext& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfWeakNext& formula) { result = true; }
-void EvalVisitor::visit(const logic::LTLfUntil& formula) { result = false; }
-void EvalVisitor::visit(const logic::LTLfRelease& formula) { result = true; }
-void EvalVisitor::visit(const logic::LTLfEventually& formula) {
-  result = false;
-}
-void EvalVisitor::visit(const logic::LTLfAlways& formula) { result = true; }
-
-bool EvalVisitor::apply(const logic::LTLfFormula& formula) {
-  formula.accept(*this);
-  return result;
+bool EvalVisitor::visit(const logic::LTLfNext& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfWeakNext& formula) { return true; }
+bool EvalVisitor::visit(const logic::LTLfUntil& formula) { return false; }
+bool EvalVisitor::visit(const logic::LTLfRelease& formula) { return true; }
+bool EvalVisitor::visit(const logic::LTLfEventually& formula) {
+  return false;
 }
+bool EvalVisitor::visit(const logic::LTLfAlways& formula) { return true; }
 
 bool eval(const logic::LTLfFormula& formula) {
-  EvalVisitor visitor{};
-  return visitor.apply(formula);
+  return formula.accepts_empty_trace();
 }
 
 } // namespace core
@@ -0,0 +1,84 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cynthia/gc_policy.hpp>
+#include <cynthia/logger.hpp>
+
+namespace cynthia {
+namespace core {
+
+bool GcPolicy::should_collect_(std::size_t live_size,
+                               std::size_t dead_size) const {
+  auto total_size = live_size + dead_size;
+  if (dead_size == 0) {
+    return false;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - last_collection_;
+  bool interval_elapsed =
+      statistics_.nb_collections == 0 or elapsed >= options_.min_interval;
+  if (options_.memory_budget > 0 and total_size > options_.memory_budget) {
+    return interval_elapsed and
+           dead_size >= options_.budget_dead_ratio * options_.memory_budget;
+  }
+  if (total_size < size_after_last_collection_ + options_.allocation_step) {
+    return false;
+  }
+  if (dead_size < options_.dead_ratio * total_size) {
+    return false;
+  }
+  return interval_elapsed;
+}
+
+bool GcPolicy::check(DdManager& manager) {
+  ++statistics_.nb_checks;
+  auto live_size = manager.live_size();
+  auto dead_size = manager.dead_size();
+  if (!should_collect_(live_size, dead_size)) {
+    return false;
+  }
+  collect_(manager, live_size, dead_size);
+  return true;
+}
+
+void GcPolicy::collect_(DdManager& manager, std::size_t live_size,
+                        std::size_t dead_size) {
+  auto start = std::chrono::steady_clock::now();
+  manager.garbage_collect();
+  last_collection_ = std::chrono::steady_clock::now();
+  double pause_ms =
+      std::chrono::duration<double, std::milli>(last_collection_ - start)
+          .count();
+
+  auto live_size_after = manager.live_size();
+  auto dead_size_after = manager.dead_size();
+  size_after_last_collection_ = live_size_after + dead_size_after;
+  ++statistics_.nb_collections;
+  statistics_.freed_size +=
+      live_size + dead_size - size_after_last_collection_;
+  statistics_.total_pause_ms += pause_ms;
+  statistics_.max_pause_ms = std::max(statistics_.max_pause_ms, pause_ms);
+
+  utils::Logger logger("gc");
+  logger.debug("garbage collection {}: live size {} -> {}, dead size {} -> {}, "
+               "{}ms",
+               statistics_.nb_collections, live_size, live_size_after,
+               dead_size, dead_size_after, pause_ms);
+}
+
+} // namespace core
+} // namespace cynthia
@@ -21,8 +21,9 @@
 namespace cynthia {
 namespace core {
 
-void Graph::insert_with_default_(std::map<Node, std::map<size_t, Node>>& m,
-                                 Node start, size_t action, Node end) {
+void GraphBase::insert_with_default_(
+    std::map<Node, std::map<size_t, Node>>& m, Node start, size_t action,
+    Node end) {
   auto start_item = m.find(start);
   if (start_item == m.end()) {
     auto new_value = std::map<size_t, Node>();
@@ -37,7 +38,7 @@ void Graph::insert_with_default_(std::map<Node, std::map<size_t, Node>>& m,
   }
   start_item->second[action] = end;
 }
-void Graph::insert_backward_with_default_(
+void GraphBase::insert_backward_with_default_(
     std::map<Node, std::map<size_t, std::set<Node>>>& m, Node start,
     size_t action, Node end) {
   auto start_item = m.find(start);
@@ -51,24 +52,18 @@ void Graph::insert_backward_with_default_(
   start_item->second[action].insert(start);
 }
 
-void Graph::add_transition(Node start, SddNode* action, Node end) {
-  SddSize action_id = sdd_id(action);
-  action_by_id[sdd_id(action)] = action;
+void GraphBase::add_transition_(Node start, size_t action_id, Node end) {
   insert_with_default_(transitions, start, action_id, end);
   insert_backward_with_default_(backward_transitions, start, action_id, end);
 }
 
-std::map<size_t, Node> Graph::get_successors(Node start) const {
+std::map<size_t, Node> GraphBase::get_successors(Node start) const {
   return get_or_empty_(transitions, start);
 }
 
-std::map<size_t, std::set<Node>> Graph::get_predecessors(Node end) const {
+std::map<size_t, std::set<Node>> GraphBase::get_predecessors(Node end) const {
   return get_or_empty_(backward_transitions, end);
 }
 
-SddNode* Graph::get_action_by_id(SddSize action_id) const {
-  return action_by_id.at(action_id);
-}
-
 } // namespace core
 } // namespace cynthia
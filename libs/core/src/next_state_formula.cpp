@@ -0,0 +1,134 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/logic/utils.hpp>
+#include <cynthia/next_state_formula.hpp>
+
+namespace cynthia {
+namespace core {
+
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfTrue& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfFalse& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfPropTrue& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfPropFalse& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfAtom& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfNot& formula) {
+  logic::throw_expected_nnf();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfPropositionalNot& formula) {
+  return formula.shared_from_this();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfAnd& formula) {
+  return logic::forward_call_to_arguments(
+      formula,
+      [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const logic::vec_ptr& container) {
+        return formula.ctx().make_and(container);
+      });
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfOr& formula) {
+  return logic::forward_call_to_arguments(
+      formula,
+      [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const logic::vec_ptr& container) {
+        return formula.ctx().make_or(container);
+      });
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfImplies& formula) {
+  return logic::forward_call_to_arguments(
+      formula,
+      [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const logic::vec_ptr& container) {
+        return formula.ctx().make_implies(container);
+      });
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfEquivalent& formula) {
+  return logic::forward_call_to_arguments(
+      formula,
+      [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const logic::vec_ptr& container) {
+        return formula.ctx().make_equivalent(container);
+      });
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfXor& formula) {
+  return logic::forward_call_to_arguments(
+      formula,
+      [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const logic::vec_ptr& container) {
+        return formula.ctx().make_xor(container);
+      });
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(const logic::LTLfNext& formula) {
+  // xnf(X phi & not_end) = xnf(phi) & not_end
+  auto& c = formula.ctx();
+  return c.make_and({xnf_visitor_.apply(*formula.arg), c.make_not_end()});
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfWeakNext& formula) {
+  // xnf(WX phi | end) = xnf(phi) | end
+  auto& c = formula.ctx();
+  return c.make_or({xnf_visitor_.apply(*formula.arg), c.make_end()});
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfUntil& formula) {
+  logic::throw_expected_xnf();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfRelease& formula) {
+  logic::throw_expected_xnf();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfEventually& formula) {
+  auto not_end = formula.ctx().make_not_end();
+  if (*not_end == formula) {
+    return formula.ctx().make_tt();
+  }
+  logic::throw_expected_xnf();
+}
+logic::ltlf_ptr NextStateFormulaVisitor::visit(
+    const logic::LTLfAlways& formula) {
+  auto end = formula.ctx().make_end();
+  if (*end == formula) {
+    return formula.ctx().make_ff();
+  }
+  logic::throw_expected_xnf();
+}
+
+logic::ltlf_ptr next_state_formula(const logic::LTLfFormula& formula) {
+  auto xnf_visitor = XnfVisitor{};
+  auto visitor = NextStateFormulaVisitor{xnf_visitor};
+  return visitor.apply(formula);
+}
+
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,167 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cynthia/sdd_dd.hpp>
+#include <stdexcept>
+
+namespace cynthia {
+namespace core {
+
+SddDdManager::SddDdManager(size_t nb_state_variables, size_t nb_env_variables,
+                           size_t nb_system_variables, Vtree* vtree,
+                           const VtreeSearchOptions& vtree_search_options)
+    : DdManager{nb_state_variables, nb_env_variables, nb_system_variables},
+      vtree_{vtree}, vtree_minimizer_{vtree_search_options} {
+  manager_ = sdd_manager_new(vtree_);
+  regions_ = VtreeRegions(manager_);
+}
+
+SddDdManager::~SddDdManager() {
+  sdd_manager_free(manager_);
+  sdd_vtree_free(vtree_);
+}
+
+DdNode SddDdManager::dd_true() const {
+  return to_node_(sdd_manager_true(manager_));
+}
+
+DdNode SddDdManager::dd_false() const {
+  return to_node_(sdd_manager_false(manager_));
+}
+
+DdNode SddDdManager::literal(long literal) {
+  return to_node_(sdd_manager_literal(literal, manager_));
+}
+
+DdNode SddDdManager::apply(DdNode first, DdNode second, DdOp op) {
+  return to_node_(sdd_apply(to_sdd_(first), to_sdd_(second),
+                            op == DdOp::conjoin ? CONJOIN : DISJOIN,
+                            manager_));
+}
+
+DdNode SddDdManager::negate(DdNode node) {
+  return to_node_(sdd_negate(to_sdd_(node), manager_));
+}
+
+DdNode SddDdManager::exists(const std::vector<size_t>& variables,
+                            DdNode node) {
+  // indexed by SDD variable, from 1
+  std::vector<int> exists_map(nb_variables() + 1, 0);
+  for (auto variable : variables) {
+    exists_map.at(variable + 1) = 1;
+  }
+  return to_node_(
+      sdd_exists_multiple(exists_map.data(), to_sdd_(node), manager_));
+}
+
+size_t SddDdManager::id(DdNode node) const { return sdd_id(to_sdd_(node)); }
+
+long SddDdManager::literal_of(DdNode node) const {
+  auto sdd_node = to_sdd_(node);
+  return sdd_node_is_literal(sdd_node) ? sdd_node_literal(sdd_node) : 0;
+}
+
+DdRegion SddDdManager::region(DdNode node) const {
+  switch (regions_.get(to_sdd_(node)->vtree)) {
+  case UNDEFINED:
+    return DdRegion::constant;
+  case STATE:
+    return DdRegion::state;
+  case ENV:
+    return DdRegion::environment;
+  case ENV_STATE:
+    return DdRegion::env_state;
+  case SYSTEM:
+    return DdRegion::system;
+  default:
+    return DdRegion::root;
+  }
+}
+
+dd_elements_t SddDdManager::elements(DdNode node) {
+  auto sdd_node = to_sdd_(node);
+  if (!sdd_node_is_decision(sdd_node)) {
+    throw std::logic_error("only decision nodes have elements");
+  }
+  auto wrapper = SddNodeWrapper(sdd_node, regions_);
+  dd_elements_t elements;
+  elements.reserve(wrapper.nb_children());
+  for (auto it = wrapper.begin(); it != wrapper.end(); ++it) {
+    elements.emplace_back(to_node_(it.get_prime()), to_node_(it.get_sub()));
+  }
+  return elements;
+}
+
+dd_elements_t SddDdManager::decompose(DdNode node, DdGroup group) {
+  if (group == DdGroup::state) {
+    throw std::invalid_argument("cannot split a node at the state variables");
+  }
+  auto node_region = region(node);
+  if (group == DdGroup::environment and
+      (node_region == DdRegion::system or node_region == DdRegion::root)) {
+    throw std::logic_error("cannot split a node that depends on system "
+                           "variables at the environment variables");
+  }
+  // the region whose vtree node splits the group from the next ones, and
+  // the region of the nodes over the group alone
+  auto split_region =
+      group == DdGroup::system ? DdRegion::root : DdRegion::env_state;
+  auto group_region =
+      group == DdGroup::system ? DdRegion::system : DdRegion::environment;
+  if (node_region == split_region) {
+    return elements(node);
+  }
+  if (node_region == group_region) {
+    return {{node, dd_true()}, {negate(node), dd_false()}};
+  }
+  return {{dd_true(), node}};
+}
+
+void SddDdManager::ref(DdNode node) { sdd_ref(to_sdd_(node), manager_); }
+
+void SddDdManager::deref(DdNode node) { sdd_deref(to_sdd_(node), manager_); }
+
+size_t SddDdManager::garbage_collect() {
+  auto size_before = sdd_manager_count(manager_);
+  sdd_manager_garbage_collect(manager_);
+  return size_before - sdd_manager_count(manager_);
+}
+
+size_t SddDdManager::size() const { return sdd_manager_count(manager_); }
+
+size_t SddDdManager::live_size() const {
+  return sdd_manager_live_size(manager_);
+}
+
+size_t SddDdManager::dead_size() const {
+  return sdd_manager_dead_size(manager_);
+}
+
+size_t SddDdManager::node_size(DdNode node) const {
+  return sdd_size(to_sdd_(node));
+}
+
+bool SddDdManager::reorder() {
+  if (!vtree_minimizer_.at_safe_point(manager_)) {
+    return false;
+  }
+  // the vtree nodes moved
+  regions_ = VtreeRegions(manager_);
+  return true;
+}
+
+} // namespace core
+} // namespace cynthia
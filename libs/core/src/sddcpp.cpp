@@ -16,13 +16,39 @@
  */
 
 #include <cynthia/sddcpp.hpp>
+#include <stack>
 #include <stdexcept>
 
 namespace cynthia {
 namespace core {
 
-SddNodeWrapper::SddNodeWrapper(SddNode* raw, SddManager* manager)
-    : raw_{raw}, manager_{manager} {
+VtreeRegions::VtreeRegions(const SddManager* manager) {
+  auto root = sdd_manager_vtree(manager);
+  types_.assign(2 * sdd_vtree_var_count(root) - 1, UNDEFINED);
+  types_[root->position] = SYSTEM_ENV_STATE;
+  if (root->left == nullptr) {
+    return;
+  }
+  std::stack<std::pair<const Vtree*, SddNodeType>> stack;
+  stack.emplace(root->left, SYSTEM);
+  types_[root->right->position] = ENV_STATE;
+  if (root->right->left != nullptr) {
+    stack.emplace(root->right->left, ENV);
+    stack.emplace(root->right->right, STATE);
+  }
+  while (!stack.empty()) {
+    auto [vtree, type] = stack.top();
+    stack.pop();
+    types_[vtree->position] = type;
+    if (vtree->left != nullptr) {
+      stack.emplace(vtree->left, type);
+      stack.emplace(vtree->right, type);
+    }
+  }
+}
+
+SddNodeWrapper::SddNodeWrapper(SddNode* raw, const VtreeRegions& regions)
+    : raw_{raw} {
   if (raw_ == nullptr) {
     throw std::invalid_argument("null pointer provided");
   }
@@ -31,7 +57,7 @@ SddNodeWrapper::SddNodeWrapper(SddNode* raw, SddManager* manager)
     nb_children_ = sdd_node_size(raw);
   }
   id_ = sdd_id(raw);
-  type_ = get_sdd_node_type_();
+  type_ = regions.get(raw_->vtree);
 }
 
 bool SddNodeWrapper::is_true() const { return sdd_node_is_true(raw_); }
@@ -68,33 +94,5 @@ SddNodeChildrenIterator SddNodeWrapper::end() const {
 
 long SddNodeWrapper::nb_children() const { return nb_children_; }
 
-SddNodeType SddNodeWrapper::get_sdd_node_type_() const {
-  auto this_vtree = raw_->vtree;
-  if (this_vtree == nullptr) {
-    return UNDEFINED;
-  }
-
-  if (at_vtree_root()) {
-    return SYSTEM_ENV_STATE;
-  }
-  auto root = sdd_manager_vtree(manager_);
-
-  if (sdd_vtree_is_sub(this_vtree, root->left)) {
-    return SYSTEM;
-  }
-  if (root->right != nullptr and
-      (sdd_vtree_is_sub(this_vtree, root->right->left))) {
-    return ENV;
-  }
-  if (root->right != nullptr and
-      (sdd_vtree_is_sub(this_vtree, root->right->right))) {
-    return STATE;
-  }
-  if (sdd_vtree_is_sub(this_vtree, root->right)) {
-    return ENV_STATE;
-  }
-  return UNDEFINED;
-}
-
 } // namespace core
 } // namespace cynthia
@@ -0,0 +1,132 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/spec_stream.hpp>
+#include <sstream>
+
+namespace cynthia {
+namespace core {
+
+static std::string trim(const std::string& str) {
+  const char* whitespace = " \t\r";
+  auto first = str.find_first_not_of(whitespace);
+  if (first == std::string::npos) {
+    return "";
+  }
+  auto last = str.find_last_not_of(whitespace);
+  return str.substr(first, last - first + 1);
+}
+
+static std::vector<std::string> split_words(const std::string& str) {
+  std::istringstream stream(str);
+  std::vector<std::string> words;
+  std::string word;
+  while (stream >> word) {
+    words.push_back(word);
+  }
+  return words;
+}
+
+std::runtime_error
+SpecReader::bad_format_exception_(std::size_t line_number,
+                                  const std::string& message) {
+  return std::runtime_error("Incorrect format in line " +
+                            std::to_string(line_number) +
+                            " of the spec stream: " + message + ".");
+}
+
+bool SpecReader::next(SpecRecord& record) {
+  record = SpecRecord{};
+  bool has_inputs = false;
+  bool has_outputs = false;
+  std::string last_key;
+  std::string line;
+  while (std::getline(in_, line)) {
+    ++line_number_;
+    line = trim(line);
+    if (!line.empty() and line[0] == '#') {
+      continue;
+    }
+    if (line.empty()) {
+      if (record.line_number == 0) {
+        continue;
+      }
+      break;
+    }
+    if (record.line_number == 0) {
+      record.line_number = line_number_;
+    }
+    if (line[0] != '.') {
+      if (last_key != "formula") {
+        throw bad_format_exception_(line_number_,
+                                    "unexpected line outside a formula");
+      }
+      record.formula += " " + line;
+      continue;
+    }
+    auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      throw bad_format_exception_(line_number_, "missing ':'");
+    }
+    auto key = line.substr(1, colon - 1);
+    auto value = trim(line.substr(colon + 1));
+    bool duplicate = false;
+    if (key == "name") {
+      duplicate = !record.name.empty();
+      record.name = value;
+    } else if (key == "inputs") {
+      duplicate = has_inputs;
+      has_inputs = true;
+      record.input_variables = split_words(value);
+    } else if (key == "outputs") {
+      duplicate = has_outputs;
+      has_outputs = true;
+      record.output_variables = split_words(value);
+    } else if (key == "formula") {
+      duplicate = !record.formula.empty();
+      record.formula = value;
+    } else {
+      throw bad_format_exception_(line_number_,
+                                  "unknown field '" + key + "'");
+    }
+    if (duplicate) {
+      throw bad_format_exception_(line_number_,
+                                  "duplicate field '" + key + "'");
+    }
+    last_key = key;
+  }
+
+  if (record.line_number == 0) {
+    return false;
+  }
+  if (record.formula.empty()) {
+    throw bad_format_exception_(record.line_number,
+                                "record without a formula");
+  }
+  if (!has_inputs or !has_outputs) {
+    throw bad_format_exception_(record.line_number,
+                                "record without inputs or outputs");
+  }
+  ++nb_records_;
+  if (record.name.empty()) {
+    record.name = std::to_string(nb_records_);
+  }
+  return true;
+}
+
+} // namespace core
+} // namespace cynthia
@@ -45,7 +45,7 @@ void StripNextVisitor::visit(const logic::LTLfAnd& formula) {
   result = logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_and(container);
       });
 }
@@ -53,7 +53,7 @@ void StripNextVisitor::visit(const logic::LTLfOr& formula) {
   result = logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_or(container);
       });
 }
@@ -61,7 +61,7 @@ void StripNextVisitor::visit(const logic::LTLfImplies& formula) {
   result = logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_implies(container);
       });
 }
@@ -69,7 +69,7 @@ void StripNextVisitor::visit(const logic::LTLfEquivalent& formula) {
   result = logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_equivalent(container);
       });
 }
@@ -77,7 +77,7 @@ void StripNextVisitor::visit(const logic::LTLfXor& formula) {
   result = logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_xor(container);
       });
 }
@@ -110,11 +110,6 @@ void StripNextVisitor::visit(const logic::LTLfAlways& formula) {
   logic::throw_expected_xnf();
 }
 
-logic::ltlf_ptr StripNextVisitor::apply(const logic::LTLfFormula& formula) {
-  formula.accept(*this);
-  return result;
-}
-
 logic::ltlf_ptr strip_next(const logic::LTLfFormula& formula) {
   auto visitor = StripNextVisitor{};
   return visitor.apply(formula);
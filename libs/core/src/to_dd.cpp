@@ -0,0 +1,310 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <cynthia/logic/types.hpp>
+#include <cynthia/to_dd.hpp>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace cynthia {
+namespace core {
+
+DdNode ToDdVisitor::state_literal_(const logic::LTLfFormula& formula) const {
+  auto formula_id = context_.closure_.get_state_id(formula);
+  return context_.manager->literal(formula_id + 1);
+}
+
+DdNode ToDdVisitor::atom_(const logic::LTLfAtom& atom, bool negated) const {
+  auto& manager = *context_.manager;
+  auto formula_id = context_.get_atom_id(atom);
+  auto literal = static_cast<long>(formula_id) + 1;
+  auto atom_node = manager.literal(negated ? -literal : literal);
+  if (mode_ != Mode::full) {
+    return atom_node;
+  }
+  // (a & tt) | (~a & ff): an atom is false on the empty trace
+  auto tt = state_literal_(*atom.ctx().make_tt());
+  auto ff = state_literal_(*atom.ctx().make_ff());
+  return manager.disjoin(manager.conjoin(atom_node, tt),
+                         manager.conjoin(manager.negate(atom_node), ff));
+}
+
+/*
+ * Conjoins or disjoins the nodes of the arguments of the formula.
+ *
+ * Instead of folding the arguments from left to right, the two smallest
+ * operands are combined first and the result goes back among the operands,
+ * as in a Huffman tree: large diagrams are only combined at the end, and
+ * the apply calls form a balanced tree. The neutral constant is dropped,
+ * and the absorbing one is returned as soon as an operand or an
+ * intermediate result reduces to it.
+ */
+DdNode ToDdVisitor::nary_apply_(const logic::LTLfBinaryOp& formula, DdOp op) {
+  auto& manager = *context_.manager;
+  auto absorbing = op == DdOp::conjoin ? manager.dd_false() : manager.dd_true();
+  auto neutral = op == DdOp::conjoin ? manager.dd_true() : manager.dd_false();
+  // ordered by size, then by id to make the schedule deterministic
+  using operand_t = std::tuple<size_t, size_t, DdNode>;
+  std::priority_queue<operand_t, std::vector<operand_t>,
+                      std::greater<operand_t>>
+      operands;
+  auto push = [&](DdNode node) {
+    operands.emplace(manager.node_size(node), manager.id(node), node);
+  };
+  auto pop = [&operands]() {
+    auto node = std::get<2>(operands.top());
+    operands.pop();
+    return node;
+  };
+  auto release_operands = [&]() {
+    while (!operands.empty()) {
+      manager.deref(pop());
+    }
+  };
+
+  for (const auto& arg : formula.args) {
+    auto node = apply(*arg);
+    if (node == absorbing) {
+      release_operands();
+      return node;
+    }
+    if (node == neutral) {
+      manager.deref(node);
+      continue;
+    }
+    push(node);
+  }
+  if (operands.empty()) {
+    return own_(neutral);
+  }
+
+  while (operands.size() > 1) {
+    auto first = pop();
+    auto second = pop();
+    auto result = own_(manager.apply(first, second, op));
+    manager.deref(first);
+    manager.deref(second);
+    context_.call_gc_vtree();
+    if (result == absorbing) {
+      release_operands();
+      return result;
+    }
+    push(result);
+  }
+  return pop();
+}
+
+DdNode ToDdVisitor::visit(const logic::LTLfTrue& formula) {
+  return own_(mode_ == Mode::full ? state_literal_(formula)
+                                  : context_.manager->dd_true());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfFalse& formula) {
+  return own_(mode_ == Mode::full ? state_literal_(formula)
+                                  : context_.manager->dd_false());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfPropTrue& formula) {
+  return own_(mode_ == Mode::full
+                  ? state_literal_(*formula.ctx().make_not_end())
+                  : context_.manager->dd_true());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfPropFalse& formula) {
+  return own_(context_.manager->dd_false());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfAtom& formula) {
+  return own_(atom_(formula, false));
+}
+DdNode ToDdVisitor::visit(const logic::LTLfNot& formula) {
+  logic::throw_expected_nnf();
+}
+DdNode ToDdVisitor::visit(const logic::LTLfPropositionalNot& formula) {
+  return own_(atom_(*formula.get_atom(), true));
+}
+DdNode ToDdVisitor::visit(const logic::LTLfAnd& formula) {
+  return nary_apply_(formula, DdOp::conjoin);
+}
+DdNode ToDdVisitor::visit(const logic::LTLfOr& formula) {
+  return nary_apply_(formula, DdOp::disjoin);
+}
+DdNode ToDdVisitor::visit(const logic::LTLfImplies& formula) {
+  if (mode_ != Mode::full) {
+    logic::throw_expected_nnf();
+  }
+  auto& manager = *context_.manager;
+  auto result = own_(manager.dd_true());
+  for (const auto& arg : formula.args) {
+    auto node = apply(*arg);
+    auto next = own_(manager.disjoin(manager.negate(result), node));
+    manager.deref(node);
+    manager.deref(result);
+    result = next;
+    context_.call_gc_vtree();
+  }
+  return result;
+}
+DdNode ToDdVisitor::visit(const logic::LTLfEquivalent& formula) {
+  if (mode_ != Mode::full) {
+    logic::throw_expected_nnf();
+  }
+  return apply(*simplify(formula));
+}
+DdNode ToDdVisitor::visit(const logic::LTLfXor& formula) {
+  if (mode_ != Mode::full) {
+    logic::throw_expected_nnf();
+  }
+  return apply(*simplify(formula));
+}
+DdNode ToDdVisitor::visit(const logic::LTLfNext& formula) {
+  return own_(mode_ == Mode::full            ? state_literal_(formula)
+              : mode_ == Mode::realizability ? context_.manager->dd_false()
+                                             : context_.manager->dd_true());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfWeakNext& formula) {
+  return own_(mode_ == Mode::full ? state_literal_(formula)
+                                  : context_.manager->dd_true());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfUntil& formula) {
+  if (mode_ == Mode::full) {
+    logic::throw_expected_xnf();
+  }
+  if (mode_ == Mode::unrealizability) {
+    return apply(*formula.ctx().make_or(formula.args));
+  }
+  return apply(**formula.args.rbegin());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfRelease& formula) {
+  if (mode_ == Mode::full) {
+    logic::throw_expected_xnf();
+  }
+  return apply(**formula.args.rbegin());
+}
+DdNode ToDdVisitor::visit(const logic::LTLfEventually& formula) {
+  if (mode_ == Mode::realizability) {
+    return apply(*formula.arg);
+  }
+  if (mode_ == Mode::unrealizability) {
+    return own_(context_.manager->dd_true());
+  }
+  auto not_end = formula.ctx().make_not_end();
+  if (*not_end == formula) {
+    return own_(state_literal_(formula));
+  }
+  logic::throw_expected_xnf();
+}
+DdNode ToDdVisitor::visit(const logic::LTLfAlways& formula) {
+  if (mode_ != Mode::full) {
+    return apply(*formula.arg);
+  }
+  auto end = formula.ctx().make_end();
+  if (*end == formula) {
+    return own_(state_literal_(formula));
+  }
+  logic::throw_expected_xnf();
+}
+
+ToDdVisitor::~ToDdVisitor() {
+  cache_.for_each_result(
+      [this](DdNode node) { context_.manager->deref(node); });
+}
+
+DdNode ToDdVisitor::apply(const logic::LTLfFormula& formula) {
+  auto node = StaticMemoizingVisitor::apply(formula);
+  context_.call_gc_vtree();
+  return node;
+}
+
+DdNode to_dd(const logic::LTLfFormula& formula,
+             ForwardSynthesis::Context& context) {
+  auto formula_ptr = formula.shared_from_this();
+  if (auto cached_result = context.formula_to_node.find(formula_ptr)) {
+    return cached_result->get();
+  }
+  auto visitor = ToDdVisitor{context, ToDdVisitor::Mode::full};
+  // the cache takes over the reference of the visitor result, which keeps
+  // the node alive across garbage collections
+  auto result = visitor.apply(formula);
+  context.formula_to_node.insert(formula_ptr,
+                                 DdRef::adopt(result, *context.manager));
+  return result;
+}
+
+logic::ltlf_ptr factored_or(
+    const std::vector<std::pair<logic::ltlf_ptr, logic::ltlf_ptr>>& elements,
+    logic::Context& context) {
+  // the primes of each sub, in the order of the elements
+  std::vector<std::pair<logic::ltlf_ptr, logic::vec_ptr>> primes_by_sub;
+  std::unordered_map<const logic::LTLfFormula*, size_t> sub_index;
+  for (const auto& [prime, sub] : elements) {
+    if (logic::is_a<logic::LTLfFalse>(*sub)) {
+      continue;
+    }
+    auto [it, inserted] = sub_index.emplace(sub.get(), primes_by_sub.size());
+    if (inserted) {
+      primes_by_sub.emplace_back(sub, logic::vec_ptr{});
+    }
+    primes_by_sub[it->second].second.push_back(prime);
+  }
+  logic::vec_ptr terms;
+  terms.reserve(primes_by_sub.size());
+  for (const auto& [sub, primes] : primes_by_sub) {
+    terms.push_back(context.make_and({context.make_or(primes), sub}));
+  }
+  return context.make_or(terms);
+}
+
+logic::ltlf_ptr dd_to_formula(DdNode node, ForwardSynthesis::Context& context) {
+  auto& manager = *context.manager;
+  auto node_id = manager.id(node);
+  if (auto cached = context.node_id_to_formula.find(node_id)) {
+    return *cached;
+  }
+  logic::ltlf_ptr result;
+  if (manager.is_false(node)) {
+    result = context.ast_manager->make_ff();
+  } else if (manager.is_true(node)) {
+    result = context.ast_manager->make_tt();
+  } else if (auto literal = manager.literal_of(node)) {
+    auto formula = context.get_formula(std::labs(literal) - 1);
+    if (literal < 0) {
+      if (logic::is_a<logic::LTLfAtom>(*formula)) {
+        result = context.ast_manager->make_prop_not(formula);
+      } else {
+        // if not an atom ignore, it is a state component
+        result = context.ast_manager->make_tt();
+      }
+    } else {
+      result = formula;
+    }
+  } else {
+    auto elements = manager.elements(node);
+    std::vector<std::pair<logic::ltlf_ptr, logic::ltlf_ptr>> args;
+    args.reserve(elements.size());
+    for (const auto& element : elements) {
+      auto prime = dd_to_formula(element.first, context);
+      auto sub = dd_to_formula(element.second, context);
+      args.emplace_back(prime, sub);
+    }
+    result = factored_or(args, *context.ast_manager);
+  }
+
+  context.node_id_to_formula.insert(node_id, result);
+  return result;
+}
+
+} // namespace core
+} // namespace cynthia
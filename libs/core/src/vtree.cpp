@@ -16,10 +16,17 @@
  */
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cynthia/logic/ltlf.hpp>
 #include <cynthia/vtree.hpp>
-#include <fstream>
-#include <sstream>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <stack>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace cynthia {
 namespace core {
@@ -34,8 +41,11 @@ void VTreeBuilder::check_partition_superset_of_atoms() const {
 }
 
 VTreeBuilder::VTreeBuilder(const Closure& closure,
-                           const InputOutputPartition& partition)
-    : closure_{closure}, partition_{partition} {
+                           const InputOutputPartition& partition,
+                           const VtreeOptions& options,
+                           logic::ltlf_ptr formula)
+    : closure_{closure}, partition_{partition}, options_{options},
+      formula_{std::move(formula)} {
   check_partition_superset_of_atoms();
 }
 
@@ -44,20 +54,26 @@ Vtree* VTreeBuilder::get_vtree() {
     return result;
   }
   executed = true;
+  auto env_order =
+      atom_order_(partition_.input_variables, options_.environment.order);
+  auto system_order =
+      atom_order_(partition_.output_variables, options_.system.order);
+  auto state_order = state_order_(env_order, system_order);
+
   size_t offset = 1;
   // build the state root
-  auto state_leaves = build_leaves(closure_.nb_formulas(), offset);
-  auto state_root = build_binary_tree_from_list(state_leaves);
+  auto state_leaves = build_leaves(state_order, offset);
+  auto state_root = build_tree(state_leaves, options_.state.shape);
 
   // build the env root
   offset = offset + state_leaves.size();
-  auto env_leaves = build_leaves(partition_.input_variables.size(), offset);
-  auto env_root = build_binary_tree_from_list(env_leaves);
+  auto env_leaves = build_leaves(env_order, offset);
+  auto env_root = build_tree(env_leaves, options_.environment.shape);
 
   // build the system root
   offset = offset + env_leaves.size();
-  auto system_leaves = build_leaves(partition_.output_variables.size(), offset);
-  auto system_root = build_binary_tree_from_list(system_leaves);
+  auto system_leaves = build_leaves(system_order, offset);
+  auto system_root = build_tree(system_leaves, options_.system.shape);
 
   // build the final root
   auto env_state_root = std::make_shared<VTreeNode>();
@@ -67,17 +83,56 @@ Vtree* VTreeBuilder::get_vtree() {
   root->left = system_root;
   root->right = env_state_root;
 
-  // save to a temporary file
-  auto vtree_string = print_vtree(root);
-  std::string filename = std::tmpnam(nullptr);
-  std::ofstream temp_file;
-  temp_file.open(filename);
-  temp_file << vtree_string;
-  temp_file.close();
-  result = sdd_vtree_read(filename.c_str());
+  result = read_vtree(print_vtree(root));
   return result;
 }
 
+Vtree* VTreeBuilder::read_vtree(const std::string& vtree_string) {
+  int fd = -1;
+  std::string filename;
+  bool is_temporary_file = false;
+  if (std::filesystem::exists("/proc/self/fd")) {
+    fd = memfd_create("vtree", MFD_CLOEXEC);
+    filename = "/proc/self/fd/" + std::to_string(fd);
+  }
+  if (fd == -1) {
+    // no anonymous files here, fall back to a temporary file
+    filename =
+        (std::filesystem::temp_directory_path() / "cynthia-vtree-XXXXXX")
+            .string();
+    fd = mkstemp(filename.data());
+    if (fd == -1) {
+      throw std::runtime_error("cannot create a file for the vtree: " +
+                               std::string(std::strerror(errno)));
+    }
+    is_temporary_file = true;
+  }
+  const char* data = vtree_string.data();
+  size_t remaining = vtree_string.size();
+  while (remaining > 0) {
+    auto written = write(fd, data, remaining);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      auto message = std::string(std::strerror(errno));
+      close(fd);
+      if (is_temporary_file) {
+        unlink(filename.c_str());
+      }
+      throw std::runtime_error("cannot write the vtree: " + message);
+    }
+    data += written;
+    remaining -= written;
+  }
+  auto vtree = sdd_vtree_read(filename.c_str());
+  close(fd);
+  if (is_temporary_file) {
+    unlink(filename.c_str());
+  }
+  return vtree;
+}
+
 vtree_node_ptr VTreeBuilder::build_binary_tree_from_list(
     const std::vector<vtree_node_ptr>& leaves) {
   if (leaves.empty()) {
@@ -104,17 +159,239 @@ vtree_node_ptr VTreeBuilder::build_binary_tree_from_list(
   return result;
 }
 
-std::vector<vtree_node_ptr> VTreeBuilder::build_leaves(size_t size,
-                                                       size_t offset) {
-  std::vector<vtree_node_ptr> leaves(size);
-  size_t index = offset;
-  std::transform(leaves.begin(), leaves.end(), leaves.begin(),
-                 [&index](vtree_node_ptr& _) {
-                   return std::make_shared<VTreeNode>(index++);
-                 });
+vtree_node_ptr VTreeBuilder::build_right_linear_tree_from_list(
+    const std::vector<vtree_node_ptr>& leaves) {
+  if (leaves.empty()) {
+    throw std::invalid_argument("vector of leaves must be non-empty");
+  }
+  auto result = leaves.back();
+  for (auto it = leaves.rbegin() + 1; it != leaves.rend(); ++it) {
+    auto new_node = std::make_shared<VTreeNode>();
+    new_node->left = *it;
+    new_node->right = result;
+    result = new_node;
+  }
+  return result;
+}
+
+vtree_node_ptr
+VTreeBuilder::build_tree(const std::vector<vtree_node_ptr>& leaves,
+                         VtreeShape shape) {
+  switch (shape) {
+  case VtreeShape::balanced:
+    return build_binary_tree_from_list(leaves);
+  case VtreeShape::right_linear:
+    return build_right_linear_tree_from_list(leaves);
+  }
+  throw std::invalid_argument("unknown vtree shape");
+}
+
+std::vector<vtree_node_ptr>
+VTreeBuilder::build_leaves(const std::vector<size_t>& order, size_t offset) {
+  std::vector<vtree_node_ptr> leaves;
+  leaves.reserve(order.size());
+  for (auto index : order) {
+    leaves.push_back(std::make_shared<VTreeNode>(offset + index));
+  }
   return leaves;
 }
 
+std::vector<size_t> VTreeBuilder::cooccurrence_order(
+    const std::vector<std::vector<size_t>>& features) {
+  auto n = features.size();
+  std::unordered_map<size_t, std::vector<size_t>> variables_by_feature;
+  for (size_t i = 0; i < n; ++i) {
+    for (auto feature : features[i]) {
+      variables_by_feature[feature].push_back(i);
+    }
+  }
+  std::vector<bool> placed(n, false);
+  std::vector<size_t> weights(n, 0);
+  std::vector<size_t> result;
+  result.reserve(n);
+  while (result.size() < n) {
+    // the best unplaced variable, by weight and then by number of features
+    size_t next = n;
+    for (size_t i = 0; i < n; ++i) {
+      if (placed[i]) {
+        continue;
+      }
+      if (next == n or weights[i] > weights[next] or
+          (weights[i] == weights[next] and
+           features[i].size() > features[next].size())) {
+        next = i;
+      }
+    }
+    placed[next] = true;
+    result.push_back(next);
+    std::fill(weights.begin(), weights.end(), 0);
+    for (auto feature : features[next]) {
+      for (auto variable : variables_by_feature[feature]) {
+        ++weights[variable];
+      }
+    }
+  }
+  return result;
+}
+
+const std::unordered_map<const logic::LTLfFormula*, size_t>&
+VTreeBuilder::dfs_positions_() {
+  if (dfs_visited_) {
+    return dfs_positions_cache_;
+  }
+  dfs_visited_ = true;
+  std::vector<logic::ltlf_ptr> roots;
+  if (formula_) {
+    roots.push_back(formula_);
+  } else {
+    roots.assign(closure_.begin_formulas(), closure_.end_formulas());
+  }
+  std::stack<const logic::LTLfFormula*> stack;
+  for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+    stack.push(it->get());
+  }
+  while (!stack.empty()) {
+    const auto* formula = stack.top();
+    stack.pop();
+    if (!dfs_positions_cache_.emplace(formula, dfs_positions_cache_.size())
+             .second) {
+      continue;
+    }
+    if (const auto* unary = dynamic_cast<const logic::LTLfUnaryOp*>(formula)) {
+      stack.push(unary->arg.get());
+    } else if (const auto* binary =
+                   dynamic_cast<const logic::LTLfBinaryOp*>(formula)) {
+      for (auto it = binary->args.rbegin(); it != binary->args.rend(); ++it) {
+        stack.push(it->get());
+      }
+    }
+  }
+  return dfs_positions_cache_;
+}
+
+static std::vector<size_t> sort_by_key(const std::vector<size_t>& keys) {
+  std::vector<size_t> result(keys.size());
+  std::iota(result.begin(), result.end(), 0);
+  std::stable_sort(result.begin(), result.end(),
+                   [&keys](size_t i, size_t j) { return keys[i] < keys[j]; });
+  return result;
+}
+
+std::vector<size_t>
+VTreeBuilder::atom_order_(const std::vector<std::string>& names,
+                          VariableOrder order) {
+  std::vector<size_t> identity(names.size());
+  std::iota(identity.begin(), identity.end(), 0);
+  if (order == VariableOrder::closure) {
+    return identity;
+  }
+  std::unordered_map<std::string, logic::atom_ptr> atom_by_name;
+  for (auto it = closure_.begin_atoms(); it != closure_.end_atoms(); ++it) {
+    atom_by_name[(*it)->name] = *it;
+  }
+  if (order == VariableOrder::cooccurrence) {
+    std::vector<std::vector<size_t>> features(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+      auto it = atom_by_name.find(names[i]);
+      if (it == atom_by_name.end()) {
+        continue;
+      }
+      for (size_t j = 0; j < closure_.nb_state_variables(); ++j) {
+        if (closure_.get_state_formula(j)->atoms().contains(
+                it->second->symbol_id)) {
+          features[i].push_back(j);
+        }
+      }
+    }
+    return cooccurrence_order(features);
+  }
+  // dfs and by_atoms
+  const auto& positions = dfs_positions_();
+  std::vector<size_t> keys(names.size(), std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto atom_it = atom_by_name.find(names[i]);
+    if (atom_it == atom_by_name.end()) {
+      continue;
+    }
+    auto position_it = positions.find(atom_it->second.get());
+    if (position_it != positions.end()) {
+      keys[i] = position_it->second;
+    }
+  }
+  return sort_by_key(keys);
+}
+
+std::vector<size_t>
+VTreeBuilder::state_order_(const std::vector<size_t>& env_order,
+                           const std::vector<size_t>& system_order) {
+  auto n = closure_.nb_state_variables();
+  std::vector<size_t> identity(n);
+  std::iota(identity.begin(), identity.end(), 0);
+  switch (options_.state.order) {
+  case VariableOrder::closure:
+    return identity;
+  case VariableOrder::cooccurrence: {
+    std::vector<std::vector<size_t>> features(n);
+    for (size_t i = 0; i < n; ++i) {
+      closure_.get_state_formula(i)->atoms().for_each(
+          [&features, i](size_t symbol_id) {
+            features[i].push_back(symbol_id);
+          });
+    }
+    return cooccurrence_order(features);
+  }
+  case VariableOrder::dfs: {
+    const auto& positions = dfs_positions_();
+    std::vector<size_t> keys(n, std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < n; ++i) {
+      const auto& formula = closure_.get_state_formula(i);
+      auto it = positions.find(formula.get());
+      if (it != positions.end()) {
+        keys[i] = it->second;
+      } else if (const auto* unary =
+                     dynamic_cast<const logic::LTLfUnaryOp*>(formula.get())) {
+        it = positions.find(unary->arg.get());
+        if (it != positions.end()) {
+          keys[i] = it->second;
+        }
+      }
+    }
+    return sort_by_key(keys);
+  }
+  case VariableOrder::by_atoms: {
+    // the rank of each atom in the environment and system groups
+    std::unordered_map<std::string, size_t> rank_by_name;
+    for (auto index : env_order) {
+      rank_by_name.emplace(partition_.input_variables[index],
+                           rank_by_name.size());
+    }
+    for (auto index : system_order) {
+      rank_by_name.emplace(partition_.output_variables[index],
+                           rank_by_name.size());
+    }
+    std::unordered_map<size_t, size_t> rank_by_symbol;
+    for (auto it = closure_.begin_atoms(); it != closure_.end_atoms(); ++it) {
+      auto rank_it = rank_by_name.find((*it)->name);
+      if (rank_it != rank_by_name.end()) {
+        rank_by_symbol[(*it)->symbol_id] = rank_it->second;
+      }
+    }
+    std::vector<size_t> keys(n, std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < n; ++i) {
+      closure_.get_state_formula(i)->atoms().for_each(
+          [&keys, &rank_by_symbol, i](size_t symbol_id) {
+            auto it = rank_by_symbol.find(symbol_id);
+            if (it != rank_by_symbol.end()) {
+              keys[i] = std::min(keys[i], it->second);
+            }
+          });
+    }
+    return sort_by_key(keys);
+  }
+  }
+  throw std::invalid_argument("unknown variable order");
+}
+
 std::string VTreeBuilder::print_vtree(const vtree_node_ptr& root) {
   vtree_node_ptr current_node;
   size_t current_index;
@@ -151,5 +428,29 @@ std::string VTreeBuilder::print_vtree(const vtree_node_ptr& root) {
   return result;
 }
 
+std::string VTreeBuilder::print_vtree(const Vtree* root) {
+  std::vector<std::string> lines;
+  // post-order, so that the children come before their parent
+  std::function<size_t(const Vtree*)> print = [&](const Vtree* vtree) {
+    if (sdd_vtree_is_leaf(vtree)) {
+      lines.push_back("L " + std::to_string(lines.size()) + " " +
+                      std::to_string(sdd_vtree_var(vtree)));
+      return lines.size() - 1;
+    }
+    auto left_index = print(sdd_vtree_left(vtree));
+    auto right_index = print(sdd_vtree_right(vtree));
+    lines.push_back("I " + std::to_string(lines.size()) + " " +
+                    std::to_string(left_index) + " " +
+                    std::to_string(right_index));
+    return lines.size() - 1;
+  };
+  print(root);
+  std::string result = "vtree " + std::to_string(lines.size()) + "\n";
+  for (const auto& line : lines) {
+    result += line + "\n";
+  }
+  return result;
+}
+
 } // namespace core
 } // namespace cynthia
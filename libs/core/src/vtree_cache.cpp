@@ -0,0 +1,148 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cynthia/logic/print.hpp>
+#include <cynthia/vtree.hpp>
+#include <cynthia/vtree_cache.hpp>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+namespace cynthia {
+namespace core {
+
+static void collect_variables(const Vtree* vtree,
+                              std::set<SddLiteral>& variables) {
+  if (sdd_vtree_is_leaf(vtree)) {
+    variables.insert(sdd_vtree_var(vtree));
+    return;
+  }
+  collect_variables(sdd_vtree_left(vtree), variables);
+  collect_variables(sdd_vtree_right(vtree), variables);
+}
+
+// whether the vtree has exactly the variables in [first, first + size)
+static bool has_variables(const Vtree* vtree, SddLiteral first,
+                          SddLiteral size) {
+  std::set<SddLiteral> variables;
+  collect_variables(vtree, variables);
+  if (variables.empty()) {
+    return size == 0;
+  }
+  return static_cast<SddLiteral>(variables.size()) == size and
+         *variables.begin() == first and
+         *variables.rbegin() == first + size - 1;
+}
+
+std::string VtreeCache::key(const Closure& closure,
+                            const InputOutputPartition& partition) {
+  std::string result;
+  for (size_t i = 0; i < closure.nb_state_variables(); ++i) {
+    result += logic::to_string(*closure.get_state_formula(i)) + "\n";
+  }
+  result += "inputs:";
+  for (const auto& name : partition.input_variables) {
+    result += " " + name;
+  }
+  result += "\noutputs:";
+  for (const auto& name : partition.output_variables) {
+    result += " " + name;
+  }
+  return result + "\n";
+}
+
+std::filesystem::path
+VtreeCache::path_(const Closure& closure,
+                  const InputOutputPartition& partition) const {
+  std::stringstream filename;
+  filename << std::hex << std::hash<std::string>{}(key(closure, partition))
+           << ".vtree";
+  return directory_ / filename.str();
+}
+
+bool VtreeCache::is_compatible(const Vtree* vtree, const Closure& closure,
+                               const InputOutputPartition& partition) {
+  auto nb_state_variables =
+      static_cast<SddLiteral>(closure.nb_state_variables());
+  auto nb_inputs = static_cast<SddLiteral>(partition.input_variables.size());
+  auto nb_outputs = static_cast<SddLiteral>(partition.output_variables.size());
+  if (vtree == nullptr or sdd_vtree_is_leaf(vtree)) {
+    return false;
+  }
+  auto env_state = sdd_vtree_right(vtree);
+  if (sdd_vtree_is_leaf(env_state)) {
+    return false;
+  }
+  return has_variables(sdd_vtree_left(vtree),
+                       nb_state_variables + nb_inputs + 1, nb_outputs) and
+         has_variables(sdd_vtree_left(env_state), nb_state_variables + 1,
+                       nb_inputs) and
+         has_variables(sdd_vtree_right(env_state), 1, nb_state_variables);
+}
+
+Vtree* VtreeCache::load(const Closure& closure,
+                        const InputOutputPartition& partition) const {
+  std::ifstream file(path_(closure, partition));
+  if (!file) {
+    return nullptr;
+  }
+  std::stringstream content;
+  content << file.rdbuf();
+  // the library does not recover from malformed files
+  if (content.str().rfind("vtree ", 0) != 0) {
+    return nullptr;
+  }
+  auto vtree = VTreeBuilder::read_vtree(content.str());
+  if (!is_compatible(vtree, closure, partition)) {
+    if (vtree != nullptr) {
+      sdd_vtree_free(vtree);
+    }
+    return nullptr;
+  }
+  return vtree;
+}
+
+bool VtreeCache::save(const Closure& closure,
+                      const InputOutputPartition& partition,
+                      const Vtree* vtree) const {
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    return false;
+  }
+  // write to a file of this process, then rename it, so that concurrent
+  // solves never read a partial entry
+  auto path = path_(closure, partition);
+  auto temporary_path = path;
+  temporary_path += "." + std::to_string(getpid());
+  {
+    std::ofstream file(temporary_path);
+    file << VTreeBuilder::print_vtree(vtree);
+    if (!file) {
+      return false;
+    }
+  }
+  std::filesystem::rename(temporary_path, path, error);
+  if (error) {
+    std::filesystem::remove(temporary_path, error);
+    return false;
+  }
+  return true;
+}
+
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,77 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cynthia/logger.hpp>
+#include <cynthia/vtree_minimizer.hpp>
+
+namespace cynthia {
+namespace core {
+
+bool VtreeMinimizer::at_safe_point(SddManager* manager) {
+  if (!options_.enabled) {
+    return false;
+  }
+  auto live_size = sdd_manager_live_size(manager);
+  if (live_size < options_.min_live_size or
+      live_size < options_.growth_factor * live_size_after_last_search_) {
+    return false;
+  }
+  search_(manager);
+  return true;
+}
+
+void VtreeMinimizer::search_(SddManager* manager) {
+  auto live_size_before = sdd_manager_live_size(manager);
+  auto start = std::chrono::steady_clock::now();
+  sdd_manager_set_vtree_search_time_limit(options_.time_limit, manager);
+  auto minimize = [this, manager](Vtree* vtree) {
+    if (sdd_vtree_is_leaf(vtree)) {
+      return;
+    }
+    if (options_.limited) {
+      sdd_vtree_minimize_limited(vtree, manager);
+    } else {
+      sdd_vtree_minimize(vtree, manager);
+    }
+  };
+  // the system, environment and state sub-vtrees, see the class comment.
+  // The search may replace the root of a sub-vtree, hence the root is
+  // looked up again before each search.
+  minimize(sdd_vtree_left(sdd_manager_vtree(manager)));
+  auto env_state = sdd_vtree_right(sdd_manager_vtree(manager));
+  minimize(sdd_vtree_left(env_state));
+  env_state = sdd_vtree_right(sdd_manager_vtree(manager));
+  minimize(sdd_vtree_right(env_state));
+
+  auto end = std::chrono::steady_clock::now();
+  double time_ms =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  live_size_after_last_search_ = sdd_manager_live_size(manager);
+  ++statistics_.nb_searches;
+  statistics_.live_size_before += live_size_before;
+  statistics_.live_size_after += live_size_after_last_search_;
+  statistics_.total_time_ms += time_ms;
+
+  utils::Logger logger("vtree");
+  logger.debug("vtree search {}: live size {} -> {}, {}ms",
+               statistics_.nb_searches, live_size_before,
+               live_size_after_last_search_, time_ms);
+}
+
+} // namespace core
+} // namespace cynthia
@@ -21,74 +21,74 @@
 namespace cynthia {
 namespace core {
 
-void XnfVisitor::visit(const logic::LTLfTrue& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfTrue& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfFalse& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfFalse& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfPropTrue& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfPropTrue& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfPropFalse& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfPropFalse& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfAtom& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfAtom& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfNot& formula) {
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfNot& formula) {
   logic::throw_expected_nnf();
 }
-void XnfVisitor::visit(const logic::LTLfPropositionalNot& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfPropositionalNot& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfAnd& formula) {
-  result = logic::forward_call_to_arguments(
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfAnd& formula) {
+  return logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_and(container);
       });
 }
-void XnfVisitor::visit(const logic::LTLfOr& formula) {
-  result = logic::forward_call_to_arguments(
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfOr& formula) {
+  return logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_or(container);
       });
 }
-void XnfVisitor::visit(const logic::LTLfImplies& formula) {
-  result = logic::forward_call_to_arguments(
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfImplies& formula) {
+  return logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_implies(container);
       });
 }
-void XnfVisitor::visit(const logic::LTLfEquivalent& formula) {
-  result = logic::forward_call_to_arguments(
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfEquivalent& formula) {
+  return logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_equivalent(container);
       });
 }
-void XnfVisitor::visit(const logic::LTLfXor& formula) {
-  result = logic::forward_call_to_arguments(
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfXor& formula) {
+  return logic::forward_call_to_arguments(
       formula,
       [this](const logic::ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const logic::vec_ptr& container) {
+      [&formula](const logic::vec_ptr& container) {
         return formula.ctx().make_xor(container);
       });
 }
-void XnfVisitor::visit(const logic::LTLfNext& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfNext& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfWeakNext& formula) {
-  result = formula.shared_from_this();
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfWeakNext& formula) {
+  return formula.shared_from_this();
 }
-void XnfVisitor::visit(const logic::LTLfUntil& formula) {
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfUntil& formula) {
   auto& c = formula.ctx();
   logic::ltlf_ptr head, tail;
   if (formula.args.size() == 2) {
@@ -103,9 +103,9 @@ void XnfVisitor::visit(const logic::LTLfUntil& formula) {
   auto left_part = c.make_and({tail, c.make_not_end()});
   auto right_part = c.make_and({head, next_until});
   auto temp = c.make_or({left_part, right_part});
-  result = apply(*temp);
+  return apply(*temp);
 }
-void XnfVisitor::visit(const logic::LTLfRelease& formula) {
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfRelease& formula) {
   auto& c = formula.ctx();
   logic::ltlf_ptr head, tail;
   if (formula.args.size() == 2) {
@@ -120,38 +120,31 @@ void XnfVisitor::visit(const logic::LTLfRelease& formula) {
   auto left_part = c.make_or({tail, c.make_end()});
   auto right_part = c.make_or({head, wnext_release});
   auto temp = c.make_and({left_part, right_part});
-  result = apply(*temp);
+  return apply(*temp);
 }
-void XnfVisitor::visit(const logic::LTLfEventually& formula) {
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfEventually& formula) {
   auto& c = formula.ctx();
   auto not_end = formula.ctx().make_not_end();
   if (*not_end == formula) {
-    result = formula.shared_from_this();
-    return;
+    return formula.shared_from_this();
   }
   // F(phi), phi != tt
   auto now_part = c.make_and({apply(*formula.arg), not_end});
   auto next_part = c.make_next(formula.shared_from_this());
   auto temp = c.make_or({now_part, next_part});
-  result = temp;
+  return temp;
 }
-void XnfVisitor::visit(const logic::LTLfAlways& formula) {
+logic::ltlf_ptr XnfVisitor::visit(const logic::LTLfAlways& formula) {
   auto& c = formula.ctx();
   auto end = formula.ctx().make_end();
   if (*end == formula) {
-    result = formula.shared_from_this();
-    return;
+    return formula.shared_from_this();
   }
   // G(phi), phi != ff
   auto now_part = c.make_or({apply(*formula.arg), end});
   auto next_part = c.make_weak_next(formula.shared_from_this());
   auto temp = c.make_and({now_part, next_part});
-  result = apply(*temp);
-}
-
-logic::ltlf_ptr XnfVisitor::apply(const logic::LTLfFormula& formula) {
-  formula.accept(*this);
-  return result;
+  return apply(*temp);
 }
 
 logic::ltlf_ptr xnf(const logic::LTLfFormula& formula) {
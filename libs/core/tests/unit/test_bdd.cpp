@@ -0,0 +1,181 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/bdd.hpp>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+// two variables per group: state 1, 2, environment 3, 4, system 5, 6
+static const long s1 = 1, s2 = 2, e1 = 3, e2 = 4, y1 = 5, y2 = 6;
+
+TEST_CASE("BDD constants and literals", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto a = manager.literal(y1);
+  auto not_a = manager.literal(-y1);
+
+  REQUIRE(manager.is_true(manager.dd_true()));
+  REQUIRE(manager.is_false(manager.dd_false()));
+  REQUIRE(manager.negate(manager.dd_true()) == manager.dd_false());
+  REQUIRE(manager.negate(a) == not_a);
+  REQUIRE(manager.negate(not_a) == a);
+  REQUIRE(manager.literal_of(a) == y1);
+  REQUIRE(manager.literal_of(not_a) == -y1);
+  REQUIRE(manager.literal_of(manager.dd_true()) == 0);
+  REQUIRE(manager.conjoin(a, not_a) == manager.dd_false());
+  REQUIRE(manager.disjoin(a, not_a) == manager.dd_true());
+  REQUIRE(manager.id(a) != manager.id(not_a));
+  REQUIRE_THROWS_AS(manager.literal(7), std::invalid_argument);
+  REQUIRE_THROWS_AS(manager.literal(0), std::invalid_argument);
+}
+
+TEST_CASE("BDD nodes are canonical", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto a = manager.literal(e1);
+  auto b = manager.literal(s2);
+  auto a_and_b = manager.conjoin(a, b);
+  auto a_and_not_b = manager.conjoin(a, manager.negate(b));
+
+  REQUIRE(manager.disjoin(a_and_b, a_and_not_b) == a);
+  REQUIRE(manager.conjoin(b, a) == a_and_b);
+  REQUIRE(manager.literal_of(a_and_b) == 0);
+  // De Morgan
+  REQUIRE(manager.negate(a_and_b) ==
+          manager.disjoin(manager.negate(a), manager.negate(b)));
+}
+
+TEST_CASE("BDD quantification", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto a = manager.literal(y1);
+  auto b = manager.literal(e2);
+  auto c = manager.literal(s1);
+  auto a_and_b = manager.conjoin(a, b);
+  auto a_or_b = manager.disjoin(a, b);
+
+  REQUIRE(manager.exists({y1 - 1}, a_and_b) == b);
+  REQUIRE(manager.forall({y1 - 1}, a_and_b) == manager.dd_false());
+  REQUIRE(manager.forall({y1 - 1}, a_or_b) == b);
+  REQUIRE(manager.exists({e2 - 1, s1 - 1}, manager.conjoin(a_and_b, c)) == a);
+  REQUIRE(manager.exists({}, a_or_b) == a_or_b);
+}
+
+TEST_CASE("BDD regions", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto system = manager.literal(y2);
+  auto environment = manager.literal(e1);
+  auto state = manager.literal(s1);
+
+  REQUIRE(manager.region(manager.dd_false()) == DdRegion::constant);
+  REQUIRE(manager.region(system) == DdRegion::system);
+  REQUIRE(manager.region(environment) == DdRegion::environment);
+  REQUIRE(manager.region(state) == DdRegion::state);
+  REQUIRE(manager.region(manager.conjoin(environment, state)) ==
+          DdRegion::env_state);
+  REQUIRE(manager.region(manager.conjoin(system, state)) == DdRegion::root);
+  REQUIRE(manager.region(manager.negate(manager.disjoin(
+              system, environment))) == DdRegion::root);
+}
+
+TEST_CASE("BDD decomposition", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto y = manager.conjoin(manager.literal(y1), manager.literal(y2));
+  auto e = manager.literal(e1);
+  auto s = manager.disjoin(manager.literal(s1), manager.literal(-s2));
+  // (y1 & y2 & e1) | (!(y1 & y2) & e1 & s)
+  auto node = manager.disjoin(
+      manager.conjoin(y, e),
+      manager.conjoin(manager.negate(y), manager.conjoin(e, s)));
+
+  auto check_partition = [&manager](DdNode node,
+                                    const dd_elements_t& elements) {
+    auto primes = manager.dd_false();
+    auto disjunction = manager.dd_false();
+    for (size_t i = 0; i < elements.size(); ++i) {
+      REQUIRE(!manager.is_false(elements[i].first));
+      for (size_t j = i + 1; j < elements.size(); ++j) {
+        REQUIRE(manager.is_false(
+            manager.conjoin(elements[i].first, elements[j].first)));
+        REQUIRE(elements[i].second != elements[j].second);
+      }
+      primes = manager.disjoin(primes, elements[i].first);
+      disjunction = manager.disjoin(
+          disjunction, manager.conjoin(elements[i].first, elements[i].second));
+    }
+    REQUIRE(manager.is_true(primes));
+    REQUIRE(disjunction == node);
+  };
+
+  SECTION("at the system variables") {
+    auto elements = manager.decompose(node, DdGroup::system);
+    REQUIRE(elements.size() == 2);
+    check_partition(node, elements);
+    for (const auto& element : elements) {
+      REQUIRE(manager.region(element.first) == DdRegion::system);
+      REQUIRE(manager.region(element.second) != DdRegion::root);
+    }
+  }
+  SECTION("at the environment variables") {
+    auto env_state_node = manager.conjoin(e, s);
+    auto elements = manager.decompose(env_state_node, DdGroup::environment);
+    REQUIRE(elements.size() == 2);
+    check_partition(env_state_node, elements);
+    REQUIRE_THROWS_AS(manager.decompose(node, DdGroup::environment),
+                      std::logic_error);
+  }
+  SECTION("a node over the group only") {
+    auto elements = manager.decompose(y, DdGroup::system);
+    REQUIRE(elements.size() == 2);
+    check_partition(y, elements);
+  }
+  SECTION("a node that does not depend on the group") {
+    auto elements = manager.decompose(s, DdGroup::system);
+    REQUIRE(elements == dd_elements_t{{manager.dd_true(), s}});
+  }
+}
+
+TEST_CASE("BDD garbage collection", "[bdd]") {
+  auto manager = BddManager(2, 2, 2);
+  auto a = manager.literal(y1);
+  auto b = manager.literal(e1);
+  auto c = manager.literal(s1);
+  auto kept = manager.conjoin(a, b);
+  auto kept_id = manager.id(kept);
+  auto dropped = manager.disjoin(manager.conjoin(a, c), b);
+  auto dropped_id = manager.id(dropped);
+  auto size_before = manager.size();
+  manager.ref(kept);
+
+  REQUIRE(manager.garbage_collect() > 0);
+  REQUIRE(manager.size() < size_before);
+  // the referenced node and its children are still there
+  REQUIRE(manager.conjoin(manager.literal(y1), manager.literal(e1)) == kept);
+  REQUIRE(manager.id(kept) == kept_id);
+  // the collected nodes get new ids when they are built again
+  auto rebuilt = manager.disjoin(
+      manager.conjoin(manager.literal(y1), manager.literal(s1)),
+      manager.literal(e1));
+  REQUIRE(manager.id(rebuilt) != dropped_id);
+
+  manager.deref(kept);
+  manager.garbage_collect();
+  REQUIRE(manager.size() == 0);
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
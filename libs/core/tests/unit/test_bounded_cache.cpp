@@ -0,0 +1,65 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/bounded_cache.hpp>
+#include <string>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+TEST_CASE("BoundedCache hits and misses", "[bounded_cache]") {
+  auto cache = BoundedCache<int, std::string>(8);
+  REQUIRE(cache.find(1) == nullptr);
+  cache.insert(1, "one");
+  auto value = cache.find(1);
+  REQUIRE(value != nullptr);
+  REQUIRE(*value == "one");
+  auto stats = cache.stats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.size == 1);
+}
+
+TEST_CASE("BoundedCache keeps at most max_size entries", "[bounded_cache]") {
+  auto cache = BoundedCache<int, int>(8);
+  for (int i = 0; i < 100; ++i) {
+    cache.insert(i, i);
+    REQUIRE(cache.size() <= 8);
+  }
+  REQUIRE(cache.find(99) != nullptr);
+  REQUIRE(cache.find(0) == nullptr);
+}
+
+TEST_CASE("BoundedCache keeps the entries in use", "[bounded_cache]") {
+  auto cache = BoundedCache<int, int>(8);
+  cache.insert(0, 0);
+  for (int i = 1; i < 100; ++i) {
+    cache.insert(i, i);
+    // a hit in the old generation moves the entry to the recent one
+    auto value = cache.find(0);
+    REQUIRE(value != nullptr);
+    REQUIRE(*value == 0);
+  }
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.find(0) == nullptr);
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
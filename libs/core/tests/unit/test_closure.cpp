@@ -268,6 +268,81 @@ TEST_CASE("Test closure of X[!]a", "[core][SDD]") {
   REQUIRE(expected == actual);
 }
 
+TEST_CASE("Test closure index of a U b", "[core][SDD]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto a_until_b = context.make_until(logic::vec_ptr{a, b});
+  auto formula_closure = closure(*a_until_b);
+
+  for (size_t i = 0; i < formula_closure.nb_formulas(); ++i) {
+    const auto& subformula = formula_closure.get_formula(i);
+    REQUIRE(formula_closure.get_id(subformula) == i);
+    REQUIRE(formula_closure.get_id(*subformula) == i);
+  }
+  auto c = context.make_atom("c");
+  REQUIRE_THROWS_AS(formula_closure.get_id(c), std::invalid_argument);
+}
+
+TEST_CASE("State variables of the closure", "[core][SDD]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto tt = context.make_tt();
+  auto ff = context.make_ff();
+  auto end = context.make_end();
+  auto not_end = context.make_not_end();
+  // a U (b & X[!](a | !b))
+  auto next = context.make_next(context.make_or({a, context.make_prop_not(b)}));
+  auto until = context.make_until({a, context.make_and({b, next})});
+  auto formula_closure = closure(*until);
+
+  auto state_variables = logic::vec_ptr{};
+  for (size_t i = 0; i < formula_closure.nb_state_variables(); ++i) {
+    const auto& formula = formula_closure.get_state_formula(i);
+    REQUIRE(Closure::is_state_variable(*formula));
+    REQUIRE(formula_closure.get_state_id(*formula) == i);
+    state_variables.push_back(formula);
+  }
+  auto expected = logic::set_ptr{tt,
+                                 ff,
+                                 end,
+                                 not_end,
+                                 next,
+                                 context.make_next(until),
+                                 context.make_next(not_end),
+                                 context.make_weak_next(end)};
+  REQUIRE(logic::set_ptr(state_variables.begin(), state_variables.end()) ==
+          expected);
+  REQUIRE(formula_closure.nb_state_variables() <
+          formula_closure.nb_formulas());
+  REQUIRE_THROWS_AS(formula_closure.get_state_id(*until),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(formula_closure.get_state_id(*a), std::invalid_argument);
+  REQUIRE_FALSE(Closure::is_state_variable(*context.make_always(a)));
+}
+
+TEST_CASE("Test closure of a very deep formula", "[core][SDD]") {
+  auto context = logic::Context();
+  const size_t depth = 1000000;
+  auto a = context.make_atom("a");
+  // a U (a U (... U a))
+  logic::ltlf_ptr f = a;
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_until(logic::vec_ptr{a, f});
+  }
+  auto formula_closure = closure(*f);
+
+  // the until formulas, their X[!], a, tt, ff, and end/not_end with their
+  // next operators
+  REQUIRE(formula_closure.nb_formulas() == 2 * depth + 7);
+  REQUIRE(formula_closure.nb_atoms() == 1);
+  REQUIRE(formula_closure.get_formula(formula_closure.get_id(*f)) == f);
+  auto next_f = context.make_next(f);
+  REQUIRE(formula_closure.get_formula(formula_closure.get_id(*next_f)) ==
+          next_f);
+}
+
 } // namespace Test
 } // namespace core
 } // namespace cynthia
\ No newline at end of file
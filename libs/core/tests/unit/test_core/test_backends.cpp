@@ -0,0 +1,163 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/core.hpp>
+#include <cynthia/parser/string_parser.hpp>
+#include <cynthia/to_dd.hpp>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+struct SynthesisCase {
+  std::string formula;
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+  // conjoin the formula with 'not end'
+  bool non_empty;
+  bool is_realizable;
+};
+
+// the expected results are the ones of the other forward synthesis tests
+static const std::vector<SynthesisCase> synthesis_cases{
+    {"tt", {"a"}, {"b"}, false, true},
+    {"ff", {"a"}, {"b"}, false, false},
+    {"true", {"a"}, {"b"}, false, true},
+    {"false", {"a"}, {"b"}, false, false},
+    {"a", {"b"}, {"a"}, false, true},
+    {"a", {"a"}, {"b"}, false, false},
+    {"~a", {"a"}, {"b"}, false, false},
+    {"X[!]a", {"b"}, {"a"}, false, true},
+    {"X[!]a", {"a"}, {"b"}, false, false},
+    {"X a", {"a"}, {"b"}, true, true},
+    {"a U b", {"a", "b"}, {"c"}, false, false},
+    {"a U b", {"a"}, {"b"}, false, true},
+    {"a U b", {"b"}, {"a"}, false, false},
+    {"a U b", {"c"}, {"a", "b"}, false, true},
+    {"a R b", {"a", "b"}, {"c"}, false, true},
+    {"F a", {"a"}, {"b"}, false, false},
+    {"F a", {"b"}, {"a"}, false, true},
+    {"G a", {"a"}, {"b"}, true, false},
+    {"G a", {"b"}, {"a"}, true, true},
+    {"G(a | ~b)", {"a"}, {"b"}, true, true},
+    {"(a & X[!](~a)) | (~a & X[!]a)", {"b"}, {"a"}, true, true},
+    {"p0 R (F p1)", {"p0"}, {"p1"}, true, true},
+    {"p0 R (F p1)", {"p1"}, {"p0"}, true, false},
+    {"(X(F(~b))) U (G(a))", {"a"}, {"b"}, true, false},
+    {"(X(F(~b))) U (G(a))", {"b"}, {"a"}, true, true},
+    {"(((p0) | (G(F(p5)))) & (F(p4))) U  (((p3) & ((~(p1)) | (F(~(p4))))) | "
+     "((p1) & (~(p3)) & (G(p4))))",
+     {"p5"},
+     {"p0", "p1", "p3", "p4"},
+     true,
+     true},
+    {"(((p0) | (G(F(p4)))) & (F(p3))) U ((p3) & ((~(p1)) | (F(~(p3)))))",
+     {"p1", "p0", "p4"},
+     {"p3"},
+     true,
+     true},
+    {"(((~(p2)) | (p4)) & (F((~(p0)) & (~(p1))))) | "
+     "((p2) & (~(p4)) & (G((p0) | (p1))))",
+     {"p2", "p4"},
+     {"p1", "p0"},
+     true,
+     true},
+    {"(~(X[!](ff))) -> (F(p0))", {"p0"}, {"dummy"}, true, false},
+};
+
+static bool dd_is_realizable(const SynthesisCase& synthesis_case,
+                             Backend backend,
+                             const GcOptions& gc_options = GcOptions{}) {
+  logic::Context context;
+  auto formula = parser::ltlf::parse_formula(context, synthesis_case.formula);
+  if (synthesis_case.non_empty) {
+    formula = context.make_and({formula, context.make_not_end()});
+  }
+  auto partition =
+      InputOutputPartition(synthesis_case.inputs, synthesis_case.outputs);
+  return is_realizable<ForwardSynthesis>(formula, partition, backend,
+                                         gc_options);
+}
+
+TEST_CASE("forward synthesis with the BDD backend", "[backends]") {
+  for (const auto& synthesis_case : synthesis_cases) {
+    INFO(synthesis_case.formula);
+    REQUIRE(dd_is_realizable(synthesis_case, Backend::bdd) ==
+            synthesis_case.is_realizable);
+  }
+}
+
+TEST_CASE("forward synthesis with the BDD backend and garbage collection",
+          "[backends]") {
+  auto gc_options = GcOptions{};
+  gc_options.enabled = true;
+  for (const auto& synthesis_case : synthesis_cases) {
+    INFO(synthesis_case.formula);
+    REQUIRE(dd_is_realizable(synthesis_case, Backend::bdd, gc_options) ==
+            synthesis_case.is_realizable);
+  }
+}
+
+TEST_CASE("forward synthesis with the BDD backend, collecting the garbage "
+          "after every operation",
+          "[backends]") {
+  auto gc_options = GcOptions{};
+  gc_options.enabled = true;
+  gc_options.dead_ratio = 0;
+  gc_options.check_interval = 1;
+  for (const auto& synthesis_case : synthesis_cases) {
+    INFO(synthesis_case.formula);
+    REQUIRE(dd_is_realizable(synthesis_case, Backend::bdd, gc_options) ==
+            synthesis_case.is_realizable);
+  }
+}
+
+TEST_CASE("forward synthesis with the SDD backend", "[backends][sdd]") {
+  for (const auto& synthesis_case : synthesis_cases) {
+    INFO(synthesis_case.formula);
+    REQUIRE(dd_is_realizable(synthesis_case, Backend::sdd) ==
+            synthesis_case.is_realizable);
+  }
+}
+
+TEST_CASE("factored disjunction of the elements", "[backends]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto s = context.make_atom("s");
+  auto t = context.make_atom("t");
+  auto tt = context.make_tt();
+  auto ff = context.make_ff();
+
+  // (a & s) | (b & s) | (c & ff) | (c & t)
+  auto result = factored_or({{a, s}, {b, s}, {c, ff}, {c, t}}, context);
+  auto expected =
+      context.make_or({context.make_and({context.make_or({a, b}), s}),
+                       context.make_and({c, t})});
+  REQUIRE(result == expected);
+
+  // a tt sub leaves the prime alone
+  REQUIRE(factored_or({{a, tt}, {b, s}}, context) ==
+          context.make_or({a, context.make_and({b, s})}));
+  REQUIRE(factored_or({{a, ff}}, context) == ff);
+  REQUIRE(factored_or({}, context) == ff);
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
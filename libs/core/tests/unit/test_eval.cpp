@@ -17,6 +17,7 @@
 
 #include <catch.hpp>
 #include <cynthia/eval.hpp>
+#include <cynthia/logic/nnf.hpp>
 
 namespace cynthia {
 namespace core {
@@ -98,6 +99,35 @@ TEST_CASE("Test eval of X a", "[core][SDD]") {
   REQUIRE(eval(*weak_next_a));
 }
 
+TEST_CASE("Test eval agrees with EvalVisitor", "[core][SDD]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto not_a = context.make_prop_not(a);
+  auto until = context.make_until({a, b});
+  auto release = context.make_release({a, context.make_tt()});
+  std::vector<logic::ltlf_ptr> formulas{
+      until,
+      release,
+      context.make_eventually(a),
+      context.make_always(not_a),
+      context.make_next(context.make_tt()),
+      context.make_weak_next(context.make_ff()),
+      context.make_and({release, context.make_always(b)}),
+      context.make_or({until, context.make_weak_next(a)}),
+      context.make_and({context.make_or({until, release}), context.make_tt()}),
+      context.make_or({context.make_prop_true(), context.make_end()}),
+  };
+  for (const auto& formula : formulas) {
+    auto visitor = EvalVisitor{};
+    REQUIRE(eval(*formula) == visitor.apply(*formula));
+    // formulas not in NNF are evaluated too
+    auto negation = context.make_not(formula);
+    REQUIRE(eval(*negation) == !eval(*formula));
+    REQUIRE(eval(*negation) == visitor.apply(*logic::to_nnf(*negation)));
+  }
+}
+
 } // namespace Test
 } // namespace core
 } // namespace cynthia
\ No newline at end of file
@@ -0,0 +1,168 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/bdd.hpp>
+#include <cynthia/gc_policy.hpp>
+#include <cynthia/sdd_dd.hpp>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+// a node that nobody references, hence dead
+static DdNode make_garbage(DdManager& manager, long first, long second) {
+  return manager.conjoin(manager.literal(first), manager.literal(second));
+}
+
+TEST_CASE("GC policy", "[core][SDD]") {
+  auto manager = SddDdManager(1, 1, 2, sdd_vtree_new(4, "balanced"));
+  auto options = GcOptions{};
+  options.enabled = true;
+
+  SECTION("disabled") {
+    auto policy = GcPolicy{};
+    make_garbage(manager, 1, 2);
+    policy.on_operation(manager);
+    policy.at_safe_point(manager);
+    REQUIRE(policy.statistics().nb_checks == 0);
+    REQUIRE(manager.dead_size() > 0);
+  }
+  SECTION("dead ratio") {
+    options.dead_ratio = 0.5;
+    auto policy = GcPolicy{options};
+    make_garbage(manager, 1, 2);
+    REQUIRE(policy.check(manager));
+    REQUIRE(manager.dead_size() == 0);
+    REQUIRE(policy.statistics().nb_collections == 1);
+    REQUIRE(policy.statistics().freed_size > 0);
+    // nothing left to collect
+    REQUIRE_FALSE(policy.check(manager));
+    REQUIRE(policy.statistics().nb_checks == 2);
+  }
+  SECTION("live nodes are kept") {
+    options.dead_ratio = 0;
+    auto policy = GcPolicy{options};
+    auto live = DdRef(make_garbage(manager, 3, 4), manager);
+    make_garbage(manager, 1, 2);
+    REQUIRE(policy.check(manager));
+    REQUIRE(manager.live_size() == manager.node_size(live.get()));
+  }
+  SECTION("memory budget") {
+    options.dead_ratio = 1;
+    auto policy = GcPolicy{options};
+    auto live = DdRef(make_garbage(manager, 3, 4), manager);
+    make_garbage(manager, 1, 2);
+    REQUIRE_FALSE(policy.check(manager));
+
+    options.memory_budget = 1;
+    policy = GcPolicy{options};
+    REQUIRE(policy.check(manager));
+  }
+  SECTION("check interval") {
+    options.check_interval = 3;
+    auto policy = GcPolicy{options};
+    policy.on_operation(manager);
+    policy.on_operation(manager);
+    REQUIRE(policy.statistics().nb_checks == 0);
+    policy.on_operation(manager);
+    REQUIRE(policy.statistics().nb_checks == 1);
+  }
+  SECTION("safe points only") {
+    options.check_interval = 1;
+    options.safe_points_only = true;
+    auto policy = GcPolicy{options};
+    policy.on_operation(manager);
+    REQUIRE(policy.statistics().nb_checks == 0);
+    policy.at_safe_point(manager);
+    REQUIRE(policy.statistics().nb_checks == 1);
+  }
+}
+
+TEST_CASE("GC policy with the BDD manager", "[core][gc]") {
+  auto manager = BddManager(1, 1, 2);
+  auto options = GcOptions{};
+  options.enabled = true;
+  options.dead_ratio = 0.5;
+  auto policy = GcPolicy{options};
+
+  auto live = DdRef(make_garbage(manager, 3, 4), manager);
+  make_garbage(manager, 1, 2);
+  // the nodes created since the last collection count as dead
+  REQUIRE(manager.live_size() == 0);
+  REQUIRE(policy.check(manager));
+  REQUIRE(manager.size() == manager.node_size(live.get()));
+  REQUIRE(manager.live_size() == manager.size());
+  REQUIRE(manager.dead_size() == 0);
+  REQUIRE_FALSE(policy.check(manager));
+
+  make_garbage(manager, 1, 2);
+  REQUIRE(manager.dead_size() > 0);
+  REQUIRE(policy.check(manager));
+  REQUIRE(policy.statistics().nb_collections == 2);
+}
+
+TEST_CASE("GC policy near the memory budget", "[core][gc]") {
+  auto manager = BddManager(4, 4, 8);
+  auto live = DdRef(manager.literal(1), manager);
+  for (long variable = 2; variable <= 16; ++variable) {
+    live = DdRef(manager.conjoin(live.get(), manager.literal(variable)),
+                 manager);
+  }
+  auto options = GcOptions{};
+  options.enabled = true;
+  options.dead_ratio = 0;
+  REQUIRE(GcPolicy{options}.check(manager));
+
+  // the live part alone is at the budget
+  options.dead_ratio = 1;
+  options.memory_budget = manager.live_size();
+  options.budget_dead_ratio = 0.5;
+
+  SECTION("dead part of the budget") {
+    auto policy = GcPolicy{options};
+    size_t nb_checks_over_budget = 0;
+    for (long first = 1; first <= 16; ++first) {
+      for (long second = first + 1; second <= 16; ++second) {
+        make_garbage(manager, first, -second);
+        auto dead_size = manager.dead_size();
+        if (policy.check(manager)) {
+          REQUIRE(dead_size >= options.memory_budget / 2);
+        } else if (manager.live_size() + dead_size > options.memory_budget) {
+          ++nb_checks_over_budget;
+        }
+      }
+    }
+    // the collections are spaced out, although every check is over the
+    // budget
+    REQUIRE(policy.statistics().nb_collections > 0);
+    REQUIRE(nb_checks_over_budget > policy.statistics().nb_collections);
+  }
+  SECTION("minimum interval") {
+    options.budget_dead_ratio = 0;
+    options.min_interval = std::chrono::hours(1);
+    auto policy = GcPolicy{options};
+    make_garbage(manager, 1, -2);
+    REQUIRE(policy.check(manager));
+    make_garbage(manager, 1, -3);
+    REQUIRE_FALSE(policy.check(manager));
+    REQUIRE(policy.statistics().nb_collections == 1);
+  }
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,93 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch.hpp>
+#include <cynthia/next_state_formula.hpp>
+#include <cynthia/strip_next.hpp>
+#include <cynthia/xnf.hpp>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+static logic::ltlf_ptr two_passes(const logic::LTLfFormula& formula) {
+  return xnf(*strip_next(formula));
+}
+
+TEST_CASE("Test next state formula of propositional formulas",
+          "[core][next_state]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto not_b = context.make_prop_not(context.make_atom("b"));
+  auto f = context.make_or({a, not_b});
+  REQUIRE(next_state_formula(*a) == a);
+  REQUIRE(next_state_formula(*f) == f);
+  REQUIRE(next_state_formula(*context.make_end()) == context.make_ff());
+  REQUIRE(next_state_formula(*context.make_not_end()) == context.make_tt());
+}
+
+TEST_CASE("Test next state formula of next operators", "[core][next_state]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto a_until_b = context.make_until({a, b});
+  auto always_a = context.make_always(a);
+
+  auto next_until = context.make_next(a_until_b);
+  auto weak_next_always = context.make_weak_next(always_a);
+  auto f = context.make_and(
+      {next_until, context.make_or({weak_next_always, context.make_end()})});
+
+  REQUIRE(next_state_formula(*next_until) == two_passes(*next_until));
+  REQUIRE(next_state_formula(*weak_next_always) ==
+          two_passes(*weak_next_always));
+  REQUIRE(next_state_formula(*f) == two_passes(*f));
+}
+
+TEST_CASE("Test next state formula shares the XNF of next arguments",
+          "[core][next_state]") {
+  auto context = logic::Context();
+  auto a_until_b =
+      context.make_until({context.make_atom("a"), context.make_atom("b")});
+  auto next_until = context.make_next(a_until_b);
+  auto weak_next_until = context.make_weak_next(a_until_b);
+  auto f = context.make_or({next_until, weak_next_until});
+
+  auto xnf_visitor = XnfVisitor{};
+  auto visitor = NextStateFormulaVisitor{xnf_visitor};
+  REQUIRE(visitor.apply(*f) == two_passes(*f));
+  // the XNF of (a U b) is computed only once
+  auto first_stats = xnf_visitor.cache_stats();
+  REQUIRE(first_stats.hits >= 1);
+
+  // a second state with the same successor is served from the cache
+  auto misses = visitor.cache_stats().misses;
+  REQUIRE(visitor.apply(*next_until) == two_passes(*next_until));
+  REQUIRE(visitor.cache_stats().misses == misses);
+}
+
+TEST_CASE("Test next state formula of not XNF formulas",
+          "[core][next_state]") {
+  auto context = logic::Context();
+  auto a_until_b =
+      context.make_until({context.make_atom("a"), context.make_atom("b")});
+  REQUIRE_THROWS_AS(next_state_formula(*a_until_b), std::logic_error);
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
@@ -0,0 +1,77 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/spec_stream.hpp>
+#include <sstream>
+
+namespace cynthia {
+namespace core {
+namespace Test {
+
+TEST_CASE("Spec stream", "[spec_stream]") {
+  std::istringstream in("# two problems\n"
+                        "\n"
+                        ".name: first\n"
+                        ".inputs: a b\n"
+                        ".outputs: c\n"
+                        ".formula: G(a -> F(c))\n"
+                        "          & G(b -> F(c))\n"
+                        "\n"
+                        "\n"
+                        ".formula: F(c)\n"
+                        ".outputs: c\n"
+                        ".inputs: a\n");
+  auto reader = SpecReader(in);
+  SpecRecord record;
+
+  REQUIRE(reader.next(record));
+  REQUIRE(record.name == "first");
+  REQUIRE(record.line_number == 3);
+  REQUIRE(record.formula == "G(a -> F(c)) & G(b -> F(c))");
+  REQUIRE(record.input_variables == std::vector<std::string>{"a", "b"});
+  REQUIRE(record.output_variables == std::vector<std::string>{"c"});
+
+  REQUIRE(reader.next(record));
+  REQUIRE(record.name == "2");
+  REQUIRE(record.line_number == 10);
+  REQUIRE(record.formula == "F(c)");
+  REQUIRE(record.input_variables == std::vector<std::string>{"a"});
+
+  REQUIRE_FALSE(reader.next(record));
+  REQUIRE(reader.nb_records() == 2);
+}
+
+TEST_CASE("Malformed spec stream", "[spec_stream]") {
+  SpecRecord record;
+  auto next = [&record](const std::string& text) {
+    std::istringstream in(text);
+    return SpecReader(in).next(record);
+  };
+  REQUIRE_FALSE(next("\n# nothing\n\n"));
+  REQUIRE_THROWS_AS(next(".inputs: a\n.outputs: b\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(next(".formula: a\n.outputs: b\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(next(".inputs: a\nb\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(next(".inputs a\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(next(".input: a\n"), std::runtime_error);
+  REQUIRE_THROWS_WITH(next(".inputs: a\n.outputs: b\n.inputs: c\n"),
+                      "Incorrect format in line 3 of the spec stream: "
+                      "duplicate field 'inputs'.");
+}
+
+} // namespace Test
+} // namespace core
+} // namespace cynthia
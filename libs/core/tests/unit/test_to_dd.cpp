@@ -18,7 +18,7 @@
 #include <catch.hpp>
 #include <cynthia/core.hpp>
 #include <cynthia/logic/nnf.hpp>
-#include <cynthia/to_sdd.hpp>
+#include <cynthia/to_dd.hpp>
 #include <cynthia/vtree.hpp>
 
 namespace cynthia {
@@ -30,8 +30,8 @@ TEST_CASE("Test SDD of tt", "[core][SDD]") {
   auto partition = InputOutputPartition({"a"}, {"b"});
   auto tt = logic_context.make_tt();
   auto context = ForwardSynthesis::Context(tt, partition);
-  auto sdd = to_sdd(*tt, context);
-  REQUIRE(sdd_size(sdd) == 0);
+  auto node = to_dd(*tt, context);
+  REQUIRE(context.manager->node_size(node) == 0);
 }
 
 TEST_CASE("Test SDD of ff", "[core][SDD]") {
@@ -39,8 +39,8 @@ TEST_CASE("Test SDD of ff", "[core][SDD]") {
   auto partition = InputOutputPartition({"a"}, {"b"});
   auto ff = logic_context.make_ff();
   auto context = ForwardSynthesis::Context(ff, partition);
-  auto sdd = to_sdd(*ff, context);
-  REQUIRE(sdd_size(sdd) == 0);
+  auto node = to_dd(*ff, context);
+  REQUIRE(context.manager->node_size(node) == 0);
 }
 
 TEST_CASE("Test SDD of true", "[core][SDD]") {
@@ -48,8 +48,8 @@ TEST_CASE("Test SDD of true", "[core][SDD]") {
   auto partition = InputOutputPartition({"a"}, {"b"});
   auto true_ = logic_context.make_prop_true();
   auto context = ForwardSynthesis::Context(true_, partition);
-  auto sdd = to_sdd(*true_, context);
-  REQUIRE(sdd_size(sdd) == 0);
+  auto node = to_dd(*true_, context);
+  REQUIRE(context.manager->node_size(node) == 0);
 }
 
 TEST_CASE("Test SDD of false", "[core][SDD]") {
@@ -57,16 +57,53 @@ TEST_CASE("Test SDD of false", "[core][SDD]") {
   auto partition = InputOutputPartition({"a"}, {"b"});
   auto false_ = logic_context.make_prop_true();
   auto context = ForwardSynthesis::Context(false_, partition);
-  auto sdd = to_sdd(*false_, context);
-  REQUIRE(sdd_size(sdd) == 0);
+  auto node = to_dd(*false_, context);
+  REQUIRE(context.manager->node_size(node) == 0);
 }
 TEST_CASE("Test SDD of a", "[core][SDD]") {
   auto logic_context = logic::Context();
   auto partition = InputOutputPartition({"a"}, {"b"});
   auto a = logic_context.make_atom("a");
   auto context = ForwardSynthesis::Context(a, partition);
-  auto sdd = to_sdd(*a, context);
-  REQUIRE(sdd_size(sdd) == 2);
+  auto node = to_dd(*a, context);
+  REQUIRE(context.manager->node_size(node) == 2);
+}
+
+TEST_CASE("DdRef reference counting", "[core][SDD]") {
+  auto logic_context = logic::Context();
+  auto partition = InputOutputPartition({"a"}, {"b"});
+  auto a = logic_context.make_atom("a");
+  auto b = logic_context.make_atom("b");
+  auto formula = logic_context.make_and({a, b});
+  auto context = ForwardSynthesis::Context(formula, partition);
+  auto* manager = context.sdd_manager->get_manager();
+  auto literal = [&](const logic::ltlf_ptr& atom) {
+    auto id = context.get_atom_id(dynamic_cast<const logic::LTLfAtom&>(*atom));
+    return sdd_manager_literal(id + 1, manager);
+  };
+  auto* node = sdd_conjoin(literal(a), literal(b), manager);
+  auto dd_node = reinterpret_cast<DdNode>(node);
+  REQUIRE(sdd_ref_count(node) == 0);
+  {
+    auto handle = DdRef(dd_node, *context.manager);
+    REQUIRE(sdd_ref_count(node) == 1);
+    auto copy = handle;
+    REQUIRE(sdd_ref_count(node) == 2);
+    auto moved = std::move(copy);
+    REQUIRE(sdd_ref_count(node) == 2);
+    REQUIRE(moved == handle);
+    REQUIRE_FALSE(copy);
+    copy = moved;
+    REQUIRE(sdd_ref_count(node) == 3);
+  }
+  REQUIRE(sdd_ref_count(node) == 0);
+
+  sdd_ref(node, manager);
+  {
+    auto adopted = DdRef::adopt(dd_node, *context.manager);
+    REQUIRE(sdd_ref_count(node) == 1);
+  }
+  REQUIRE(sdd_ref_count(node) == 0);
 }
 
 } // namespace Test
@@ -16,12 +16,27 @@
  */
 
 #include <catch.hpp>
+#include <cynthia/sddcpp.hpp>
 #include <cynthia/vtree.hpp>
+#include <cynthia/vtree_cache.hpp>
+#include <cynthia/vtree_minimizer.hpp>
+#include <filesystem>
+#include <set>
 
 namespace cynthia {
 namespace core {
 namespace Test {
 
+static std::set<SddLiteral> vtree_variables(Vtree* vtree) {
+  if (sdd_vtree_is_leaf(vtree)) {
+    return {sdd_vtree_var(vtree)};
+  }
+  auto result = vtree_variables(sdd_vtree_left(vtree));
+  auto right = vtree_variables(sdd_vtree_right(vtree));
+  result.insert(right.begin(), right.end());
+  return result;
+}
+
 TEST_CASE("Test VTree", "[core][SDD]") {
   logic::Context context;
 
@@ -39,8 +54,188 @@ TEST_CASE("Test VTree", "[core][SDD]") {
   auto formula_closure = closure(*ab_until_cd);
   auto builder = VTreeBuilder(formula_closure, partition);
   auto vtree = builder.get_vtree();
-  REQUIRE(vtree->var_count == 18);
+  // X(ab U cd), tt, ff, end, not_end, X(not_end), WX(end) and the atoms
+  REQUIRE(vtree->var_count == 11);
+  sdd_vtree_free(vtree);
+}
+
+TEST_CASE("Variable orders and shapes of the vtree", "[core][SDD]") {
+  logic::Context context;
+  auto inputs = std::vector<std::string>({"a", "b"});
+  auto outputs = std::vector<std::string>({"c", "d"});
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto d = context.make_atom("d");
+  auto formula = context.make_and(
+      {context.make_until({context.make_and({a, c}), b}),
+       context.make_always(context.make_or({context.make_prop_not(d), a}))});
+  auto partition = InputOutputPartition(inputs, outputs);
+  auto formula_closure = closure(*formula);
+  auto order = GENERATE(VariableOrder::closure, VariableOrder::dfs,
+                        VariableOrder::cooccurrence, VariableOrder::by_atoms);
+  auto shape = GENERATE(VtreeShape::balanced, VtreeShape::right_linear);
+  auto options = VtreeOptions{};
+  options.state = options.environment = options.system = {order, shape};
+  auto builder = VTreeBuilder(formula_closure, partition, options, formula);
+  auto vtree = builder.get_vtree();
+
+  // each group keeps its variables, whatever their order
+  SddLiteral n = formula_closure.nb_state_variables();
+  std::set<SddLiteral> state_variables;
+  for (SddLiteral i = 1; i <= n; ++i) {
+    state_variables.insert(i);
+  }
+  auto env_variables = std::set<SddLiteral>{n + 1, n + 2};
+  auto system_variables = std::set<SddLiteral>{n + 3, n + 4};
+  REQUIRE(vtree_variables(sdd_vtree_left(vtree)) == system_variables);
+  REQUIRE(vtree_variables(sdd_vtree_left(sdd_vtree_right(vtree))) ==
+          env_variables);
+  REQUIRE(vtree_variables(sdd_vtree_right(sdd_vtree_right(vtree))) ==
+          state_variables);
+  sdd_vtree_free(vtree);
+}
+
+TEST_CASE("Right-linear vtree", "[core][vtree]") {
+  auto leaves = VTreeBuilder::build_leaves(std::vector<size_t>{2, 0, 1}, 1);
+  auto root = VTreeBuilder::build_right_linear_tree_from_list(leaves);
+  REQUIRE(root->left->value == 3);
+  REQUIRE(root->right->left->value == 1);
+  REQUIRE(root->right->right->value == 2);
+  REQUIRE(root->right->right->is_leaf());
+}
+
+TEST_CASE("Co-occurrence order", "[core][vtree]") {
+  // the first variable has the most features; then each variable is
+  // followed by the one that shares the most with it
+  auto features = std::vector<std::vector<size_t>>{{0}, {1, 2}, {0, 3}, {2}};
+  REQUIRE(VTreeBuilder::cooccurrence_order(features) ==
+          std::vector<size_t>{1, 3, 2, 0});
+  REQUIRE(VTreeBuilder::cooccurrence_order({}).empty());
+}
+
+TEST_CASE("Vtree regions", "[core][SDD]") {
+  logic::Context context;
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto formula = context.make_until({a, context.make_next(b)});
+  auto partition = InputOutputPartition({"a"}, {"b"});
+  auto formula_closure = closure(*formula);
+  auto builder = VTreeBuilder(formula_closure, partition);
+  auto vtree = builder.get_vtree();
+  auto manager = sdd_manager_new(vtree);
+  sdd_vtree_free(vtree);
+  auto regions = VtreeRegions(manager);
+
+  SddLiteral state = 1;
+  SddLiteral env = formula_closure.nb_state_variables() + 1;
+  SddLiteral system = env + 1;
+  auto literal = [&](SddLiteral variable) {
+    return SddNodeWrapper(sdd_manager_literal(variable, manager), regions);
+  };
+  auto conjunction = [&](SddLiteral first, SddLiteral second) {
+    auto node = sdd_conjoin(sdd_manager_literal(first, manager),
+                            sdd_manager_literal(second, manager), manager);
+    return SddNodeWrapper(node, regions);
+  };
+  REQUIRE(literal(state).get_type() == STATE);
+  REQUIRE(conjunction(state, state + 1).get_type() == STATE);
+  REQUIRE(literal(env).get_type() == ENV);
+  REQUIRE(literal(system).get_type() == SYSTEM);
+  REQUIRE(conjunction(env, state).get_type() == ENV_STATE);
+  REQUIRE(conjunction(system, state).get_type() == SYSTEM_ENV_STATE);
+  REQUIRE(SddNodeWrapper(sdd_manager_true(manager), regions).get_type() ==
+          UNDEFINED);
+  sdd_manager_free(manager);
+}
+
+TEST_CASE("Vtree cache", "[core][SDD]") {
+  logic::Context context;
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto formula = context.make_until({a, context.make_next(b)});
+  auto partition = InputOutputPartition({"a"}, {"b"});
+  auto other_partition = InputOutputPartition({"b"}, {"a"});
+  auto formula_closure = closure(*formula);
+  auto builder = VTreeBuilder(formula_closure, partition);
+  auto vtree = builder.get_vtree();
+  REQUIRE(VtreeCache::is_compatible(vtree, formula_closure, partition));
+  auto right_linear = sdd_vtree_new(vtree->var_count, "right");
+  REQUIRE_FALSE(
+      VtreeCache::is_compatible(right_linear, formula_closure, partition));
+  sdd_vtree_free(right_linear);
+
+  auto directory =
+      std::filesystem::temp_directory_path() / "cynthia-test-vtree-cache";
+  std::filesystem::remove_all(directory);
+  auto cache = VtreeCache(directory);
+  REQUIRE(cache.load(formula_closure, partition) == nullptr);
+  REQUIRE(cache.save(formula_closure, partition, vtree));
+  auto cached_vtree = cache.load(formula_closure, partition);
+  REQUIRE(cached_vtree != nullptr);
+  REQUIRE(VTreeBuilder::print_vtree(cached_vtree) ==
+          VTreeBuilder::print_vtree(vtree));
+  REQUIRE(cache.load(formula_closure, other_partition) == nullptr);
+
+  sdd_vtree_free(cached_vtree);
+  sdd_vtree_free(vtree);
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Vtree search keeps the variable groups", "[core][SDD]") {
+  logic::Context context;
+  auto inputs = std::vector<std::string>({"a", "b"});
+  auto outputs = std::vector<std::string>({"c", "d"});
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto d = context.make_atom("d");
+  auto ab_until_cd = context.make_until(
+      {context.make_and({a, b}), context.make_and({c, d})});
+  auto partition = InputOutputPartition(inputs, outputs);
+  auto formula_closure = closure(*ab_until_cd);
+  auto builder = VTreeBuilder(formula_closure, partition);
+  auto vtree = builder.get_vtree();
+  auto manager = sdd_manager_new(vtree);
   sdd_vtree_free(vtree);
+
+  auto root = sdd_manager_vtree(manager);
+  auto system_variables = vtree_variables(sdd_vtree_left(root));
+  auto env_variables = vtree_variables(sdd_vtree_left(sdd_vtree_right(root)));
+  auto state_variables =
+      vtree_variables(sdd_vtree_right(sdd_vtree_right(root)));
+
+  // (x1 | x8) & ... & (x4 | x11), across all the groups of variables
+  auto node = sdd_manager_true(manager);
+  for (SddLiteral i = 1; i <= 4; ++i) {
+    auto clause = sdd_disjoin(sdd_manager_literal(i, manager),
+                              sdd_manager_literal(i + 7, manager), manager);
+    node = sdd_conjoin(node, clause, manager);
+  }
+  // referenced, so that the vtree search keeps it
+  sdd_ref(node, manager);
+  auto model_count = sdd_model_count(node, manager);
+
+  auto options = VtreeSearchOptions{};
+  options.enabled = true;
+  options.min_live_size = 0;
+  auto minimizer = VtreeMinimizer(options);
+  REQUIRE(minimizer.at_safe_point(manager));
+  REQUIRE(minimizer.statistics().nb_searches == 1);
+
+  root = sdd_manager_vtree(manager);
+  REQUIRE(vtree_variables(sdd_vtree_left(root)) == system_variables);
+  REQUIRE(vtree_variables(sdd_vtree_left(sdd_vtree_right(root))) ==
+          env_variables);
+  REQUIRE(vtree_variables(sdd_vtree_right(sdd_vtree_right(root))) ==
+          state_variables);
+  REQUIRE(sdd_model_count(node, manager) == model_count);
+
+  // the live size did not grow since the last search
+  REQUIRE_FALSE(minimizer.at_safe_point(manager));
+
+  sdd_deref(node, manager);
+  sdd_manager_free(manager);
 }
 } // namespace Test
 } // namespace core
@@ -127,6 +127,21 @@ TEST_CASE("Test XNF of a R b", "[core][SDD]") {
   REQUIRE(actual == expected);
 }
 
+TEST_CASE("Test XNF of a very deep formula", "[core][SDD]") {
+  auto context = logic::Context();
+  const size_t depth = 1000000;
+  auto not_end = context.make_not_end();
+  // xnf(F(phi)) = (xnf(phi) & not_end) | X[!](F(phi))
+  logic::ltlf_ptr f = context.make_atom("a");
+  logic::ltlf_ptr expected = f;
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_eventually(f);
+    expected = context.make_or(
+        {context.make_and({expected, not_end}), context.make_next(f)});
+  }
+  REQUIRE(xnf(*f) == expected);
+}
+
 } // namespace Test
 } // namespace core
 } // namespace cynthia
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch.hpp>
+#include <cynthia/logic/dispatch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/visitor.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Benchmark {
+
+// f_0 = a_0, f_{i+1} = (f_i & X(a_i)) | WX(!a_i): a tree with no sharing
+static ltlf_ptr make_chain(Context& context, size_t depth) {
+  ltlf_ptr f = context.make_atom("a_0");
+  for (size_t i = 0; i < depth; ++i) {
+    auto atom = context.make_atom("a_" + std::to_string(i));
+    auto left = context.make_and({f, context.make_next(atom)});
+    auto right = context.make_weak_next(context.make_not(atom));
+    f = context.make_or({left, right});
+  }
+  return f;
+}
+
+class VirtualNodeCounter : public Visitor {
+public:
+  size_t result = 0;
+  void visit(const LTLfTrue&) override { result = 1; }
+  void visit(const LTLfFalse&) override { result = 1; }
+  void visit(const LTLfPropTrue&) override { result = 1; }
+  void visit(const LTLfPropFalse&) override { result = 1; }
+  void visit(const LTLfAtom&) override { result = 1; }
+  void visit(const LTLfNot& f) override { result = 1 + apply(*f.arg); }
+  void visit(const LTLfPropositionalNot&) override { result = 2; }
+  void visit(const LTLfAnd& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfOr& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfImplies& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfEquivalent& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfXor& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfNext& f) override { result = 1 + apply(*f.arg); }
+  void visit(const LTLfWeakNext& f) override { result = 1 + apply(*f.arg); }
+  void visit(const LTLfUntil& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfRelease& f) override { result = 1 + apply(f.args); }
+  void visit(const LTLfEventually& f) override { result = 1 + apply(*f.arg); }
+  void visit(const LTLfAlways& f) override { result = 1 + apply(*f.arg); }
+
+  size_t apply(const LTLfFormula& f) {
+    f.accept(*this);
+    return result;
+  }
+  size_t apply(const vec_ptr& args) {
+    size_t sum = 0;
+    for (const auto& arg : args) {
+      sum += apply(*arg);
+    }
+    return sum;
+  }
+};
+
+class StaticNodeCounter {
+public:
+  size_t visit(const LTLfTrue&) { return 1; }
+  size_t visit(const LTLfFalse&) { return 1; }
+  size_t visit(const LTLfPropTrue&) { return 1; }
+  size_t visit(const LTLfPropFalse&) { return 1; }
+  size_t visit(const LTLfAtom&) { return 1; }
+  size_t visit(const LTLfNot& f) { return 1 + apply(*f.arg); }
+  size_t visit(const LTLfPropositionalNot&) { return 2; }
+  size_t visit(const LTLfAnd& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfOr& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfImplies& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfEquivalent& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfXor& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfNext& f) { return 1 + apply(*f.arg); }
+  size_t visit(const LTLfWeakNext& f) { return 1 + apply(*f.arg); }
+  size_t visit(const LTLfUntil& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfRelease& f) { return 1 + apply(f.args); }
+  size_t visit(const LTLfEventually& f) { return 1 + apply(*f.arg); }
+  size_t visit(const LTLfAlways& f) { return 1 + apply(*f.arg); }
+
+  size_t apply(const LTLfFormula& f) { return dispatch(f, *this); }
+  size_t apply(const vec_ptr& args) {
+    size_t sum = 0;
+    for (const auto& arg : args) {
+      sum += apply(*arg);
+    }
+    return sum;
+  }
+};
+
+TEST_CASE("Benchmark visitor dispatch", "[logic][benchmark][dispatch]") {
+  auto context = Context();
+  auto depth = GENERATE(100, 1000);
+  auto formula = make_chain(context, depth);
+  auto nb_nodes = VirtualNodeCounter{}.apply(*formula);
+  REQUIRE(StaticNodeCounter{}.apply(*formula) == nb_nodes);
+  auto suffix = ", " + std::to_string(nb_nodes) + " nodes";
+
+  BENCHMARK("virtual accept/visit" + suffix) {
+    return VirtualNodeCounter{}.apply(*formula);
+  };
+  BENCHMARK("switch on type code" + suffix) {
+    return StaticNodeCounter{}.apply(*formula);
+  };
+}
+
+} // namespace Benchmark
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,78 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/trace_evaluator.hpp>
+#include <random>
+
+namespace cynthia {
+namespace logic {
+namespace Benchmark {
+
+// G(req_i -> F grant_i) for every i, and G !(grant_i & grant_j) for i < j
+static ltlf_ptr make_arbiter(Context& context, size_t n) {
+  vec_ptr conjuncts;
+  for (size_t i = 0; i < n; ++i) {
+    auto request = context.make_atom("req_" + std::to_string(i));
+    auto grant = context.make_atom("grant_" + std::to_string(i));
+    conjuncts.push_back(context.make_always(context.make_or(
+        {context.make_prop_not(request), context.make_eventually(grant)})));
+    for (size_t j = 0; j < i; ++j) {
+      auto other = context.make_atom("grant_" + std::to_string(j));
+      conjuncts.push_back(context.make_always(context.make_or(
+          {context.make_prop_not(grant), context.make_prop_not(other)})));
+    }
+  }
+  return context.make_and(conjuncts);
+}
+
+static std::vector<trace_t> make_random_traces(const Context& context,
+                                               size_t nb_traces,
+                                               size_t length) {
+  std::mt19937 generator(42);
+  std::vector<trace_t> traces(nb_traces, trace_t(length));
+  for (auto& trace : traces) {
+    for (auto& instant : trace) {
+      for (size_t id = 0; id < context.nb_symbols(); ++id) {
+        if (generator() % 4 == 0) {
+          instant.push_back(id);
+        }
+      }
+    }
+  }
+  return traces;
+}
+
+TEST_CASE("Benchmark trace evaluation", "[logic][benchmark][traces]") {
+  auto context = Context();
+  auto n = GENERATE(2, 8);
+  size_t nb_traces = 4096;
+  size_t length = 100;
+  auto formula = make_arbiter(context, n);
+  auto traces = make_random_traces(context, nb_traces, length);
+  auto evaluator = TraceEvaluator(*formula);
+  auto suffix = ", " + std::to_string(evaluator.program_size()) +
+                " instructions, " + std::to_string(nb_traces * length) +
+                " trace steps";
+
+  BENCHMARK("compile" + suffix) { return TraceEvaluator(*formula); };
+  BENCHMARK("evaluate" + suffix) { return evaluator.evaluate(traces); };
+}
+
+} // namespace Benchmark
+} // namespace logic
+} // namespace cynthia
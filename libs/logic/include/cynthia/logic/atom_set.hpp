@@ -0,0 +1,147 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * An immutable set of atoms, as a bitset over their symbol ids (see
+ * SymbolTable). Sets are shared between formulas whenever possible: a
+ * unary operator has the same atoms as its argument.
+ */
+class AtomSet {
+private:
+  std::vector<uint64_t> words_;
+
+  static constexpr size_t word_size = 64;
+
+public:
+  AtomSet() = default;
+
+  static std::shared_ptr<const AtomSet> singleton(size_t symbol_id) {
+    auto result = std::make_shared<AtomSet>();
+    result->words_.resize(symbol_id / word_size + 1);
+    auto bit = symbol_id % word_size;
+    result->words_[symbol_id / word_size] = uint64_t(1) << bit;
+    return result;
+  }
+
+  bool contains(size_t symbol_id) const {
+    auto word = symbol_id / word_size;
+    return word < words_.size() and
+           (words_[word] >> (symbol_id % word_size)) & 1u;
+  }
+
+  bool empty() const {
+    for (auto word : words_) {
+      if (word != 0)
+        return false;
+    }
+    return true;
+  }
+
+  size_t size() const {
+    size_t result = 0;
+    for (auto word : words_) {
+      result += __builtin_popcountll(word);
+    }
+    return result;
+  }
+
+  bool is_subset_of(const AtomSet& other) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      auto other_word = i < other.words_.size() ? other.words_[i] : 0;
+      if ((words_[i] & ~other_word) != 0)
+        return false;
+    }
+    return true;
+  }
+
+  bool intersects(const AtomSet& other) const {
+    auto n = std::min(words_.size(), other.words_.size());
+    for (size_t i = 0; i < n; ++i) {
+      if ((words_[i] & other.words_[i]) != 0)
+        return true;
+    }
+    return false;
+  }
+
+  /*
+   * Call the function on the symbol id of each atom, in increasing order.
+   */
+  template <typename Function> void for_each(Function function) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      auto word = words_[i];
+      while (word != 0) {
+        auto bit = static_cast<size_t>(__builtin_ctzll(word));
+        function(i * word_size + bit);
+        word &= word - 1;
+      }
+    }
+  }
+
+  /*
+   * The union of the sets, where nullptr stands for the empty set. If one
+   * of them already contains all the others, it is returned instead of a
+   * new set.
+   */
+  static std::shared_ptr<const AtomSet>
+  union_of(const std::vector<std::shared_ptr<const AtomSet>>& sets) {
+    std::shared_ptr<const AtomSet> largest;
+    for (const auto& set : sets) {
+      if (set and (!largest or largest->is_subset_of(*set)))
+        largest = set;
+    }
+    bool covers_all = true;
+    for (const auto& set : sets) {
+      if (set and !set->is_subset_of(*largest)) {
+        covers_all = false;
+        break;
+      }
+    }
+    if (covers_all)
+      return largest;
+    auto result = std::make_shared<AtomSet>();
+    for (const auto& set : sets) {
+      if (!set)
+        continue;
+      if (result->words_.size() < set->words_.size())
+        result->words_.resize(set->words_.size());
+      for (size_t i = 0; i < set->words_.size(); ++i) {
+        result->words_[i] |= set->words_[i];
+      }
+    }
+    return result;
+  }
+
+  bool operator==(const AtomSet& other) const {
+    return is_subset_of(other) and other.is_subset_of(*this);
+  }
+  bool operator!=(const AtomSet& other) const { return !(*this == other); }
+};
+
+typedef std::shared_ptr<const AtomSet> atom_set_ptr;
+
+} // namespace logic
+} // namespace cynthia
@@ -16,10 +16,12 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cynthia/logic/comparable.hpp>
 #include <cynthia/logic/hashable.hpp>
 #include <cynthia/logic/hashtable.hpp>
+#include <cynthia/logic/symbol_table.hpp>
 #include <cynthia/logic/visitable.hpp>
 #include <cynthia/utils.hpp>
 #include <memory>
@@ -37,6 +39,11 @@ class AstNode : public Visitable,
 private:
   Context* m_ctx_;
 
+protected:
+  friend class HashTable;
+  // called once on a node, when the context interns it
+  virtual void on_insert_() const {}
+
 public:
   explicit AstNode(Context& ctx) : m_ctx_{&ctx} {}
   Context& ctx() const { return *m_ctx_; }
@@ -45,9 +52,17 @@ public:
   };
 };
 
+/*
+ * The context builds and hash-conses the formulas.
+ *
+ * The make_* methods can be called concurrently from several threads: the
+ * interning table is thread-safe, so equal formulas built by different
+ * threads are the same node.
+ */
 class Context {
 private:
   std::unique_ptr<HashTable> table_;
+  SymbolTable symbols_;
 
   ltlf_ptr tt;
   ltlf_ptr ff;
@@ -82,6 +97,26 @@ public:
   ltlf_ptr make_release(const vec_ptr& args);
   ltlf_ptr make_eventually(const ltlf_ptr& args);
   ltlf_ptr make_always(const ltlf_ptr& args);
+
+  /**
+   * Intern an atom name.
+   * @param name the name of the atom
+   * @return the dense id of the atom name in this context
+   */
+  size_t add_symbol(const std::string& name) { return symbols_.add(name); }
+  const SymbolTable& symbols() const { return symbols_; }
+  size_t nb_symbols() const { return symbols_.size(); }
+
+  /**
+   * @return the number of formula nodes interned in this context
+   */
+  size_t nb_nodes() const { return table_->size(); }
+  /**
+   * Free the interned nodes that are not referenced anymore outside of the
+   * context. Threads building formulas meanwhile wait for the sweep to end.
+   * @return the number of freed nodes
+   */
+  size_t collect_garbage() { return table_->collect_garbage(); }
 };
 
 template <typename T, typename caller, typename True, typename False,
@@ -89,6 +124,20 @@ template <typename T, typename caller, typename True, typename False,
 std::shared_ptr<T>
 and_or(Context& context, const vec_ptr& s, bool op_x_notx,
        std::shared_ptr<T> (Context::*const& fun_ptr)(bool x)) {
+  // fast path: arguments already in canonical order, with no constant and
+  // nothing to flatten, are kept as they are, with a linear number of
+  // comparisons
+  auto is_plain = [](const std::shared_ptr<T>& a) {
+    return !is_a<True>(*a) and !is_a<False>(*a) and !is_a<caller>(*a);
+  };
+  auto not_before = [](const std::shared_ptr<T>& a,
+                       const std::shared_ptr<T>& b) {
+    return !utils::Deref::Less()(a, b);
+  };
+  if (s.size() >= 2 and std::all_of(s.begin(), s.end(), is_plain) and
+      std::adjacent_find(s.begin(), s.end(), not_before) == s.end()) {
+    return std::make_shared<caller>(context, set_ptr(s.begin(), s.end()));
+  }
   set_ptr args;
   for (auto& a : s) {
     // handle the case when a subformula is true
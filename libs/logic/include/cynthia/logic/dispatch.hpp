@@ -0,0 +1,82 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/visitor.hpp>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * Call handler.visit() on the formula, downcast to its concrete type.
+ *
+ * This is a static alternative to accept()/Visitor: the concrete type is
+ * selected by switching on the type code of the node, and the handler's
+ * visit overloads return their result directly, so they can be inlined.
+ * The handler must provide a visit overload for every LTLf node type, all
+ * with the same return type.
+ */
+template <typename Handler>
+inline auto dispatch(const LTLfFormula& formula, Handler& handler)
+    -> decltype(handler.visit(std::declval<const LTLfTrue&>())) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfTrue:
+    return handler.visit(static_cast<const LTLfTrue&>(formula));
+  case TypeID::t_LTLfFalse:
+    return handler.visit(static_cast<const LTLfFalse&>(formula));
+  case TypeID::t_LTLfPropTrue:
+    return handler.visit(static_cast<const LTLfPropTrue&>(formula));
+  case TypeID::t_LTLfPropFalse:
+    return handler.visit(static_cast<const LTLfPropFalse&>(formula));
+  case TypeID::t_LTLfAtom:
+    return handler.visit(static_cast<const LTLfAtom&>(formula));
+  case TypeID::t_LTLfPropNot:
+    return handler.visit(static_cast<const LTLfPropositionalNot&>(formula));
+  case TypeID::t_LTLfNot:
+    return handler.visit(static_cast<const LTLfNot&>(formula));
+  case TypeID::t_LTLfAnd:
+    return handler.visit(static_cast<const LTLfAnd&>(formula));
+  case TypeID::t_LTLfOr:
+    return handler.visit(static_cast<const LTLfOr&>(formula));
+  case TypeID::t_LTLfImplies:
+    return handler.visit(static_cast<const LTLfImplies&>(formula));
+  case TypeID::t_LTLfEquivalent:
+    return handler.visit(static_cast<const LTLfEquivalent&>(formula));
+  case TypeID::t_LTLfXor:
+    return handler.visit(static_cast<const LTLfXor&>(formula));
+  case TypeID::t_LTLfNext:
+    return handler.visit(static_cast<const LTLfNext&>(formula));
+  case TypeID::t_LTLfWeakNext:
+    return handler.visit(static_cast<const LTLfWeakNext&>(formula));
+  case TypeID::t_LTLfUntil:
+    return handler.visit(static_cast<const LTLfUntil&>(formula));
+  case TypeID::t_LTLfRelease:
+    return handler.visit(static_cast<const LTLfRelease&>(formula));
+  case TypeID::t_LTLfEventually:
+    return handler.visit(static_cast<const LTLfEventually&>(formula));
+  case TypeID::t_LTLfAlways:
+    return handler.visit(static_cast<const LTLfAlways&>(formula));
+  default:
+    throw_not_supported_error();
+  }
+}
+
+} // namespace logic
+} // namespace cynthia
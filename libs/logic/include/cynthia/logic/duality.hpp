@@ -19,20 +19,31 @@
 #include <cstdint>
 #include <memory>
 
-#include <cynthia/logic/visitor.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
 
 namespace cynthia {
 namespace logic {
 
+class NNFTransformer;
+
 /*
  * Apply a negation.
  * - in case of boolean or temporal operator, apply the
  *   duality of negation to push a negation down;
  * - in case of atomic formula, return the negation of it
  */
-class NegationTransformer : public Visitor {
+class NegationTransformer : public MemoizingVisitor<ltlf_ptr> {
+private:
+  // if set, double negations are delegated to it
+  NNFTransformer* nnf_transformer_;
+
+protected:
+  void for_each_dependency_(const LTLfFormula& formula,
+                            const DependencyFunction& function) override;
+
 public:
-  ltlf_ptr result;
+  explicit NegationTransformer(NNFTransformer* nnf_transformer = nullptr)
+      : nnf_transformer_{nnf_transformer} {}
   void visit(const LTLfTrue&) override;
   void visit(const LTLfFalse&) override;
   void visit(const LTLfPropTrue&) override;
@@ -51,8 +62,6 @@ public:
   void visit(const LTLfRelease&) override;
   void visit(const LTLfEventually&) override;
   void visit(const LTLfAlways&) override;
-
-  ltlf_ptr apply(const LTLfFormula& f);
 };
 
 ltlf_ptr apply_negation(const LTLfFormula& f);
@@ -16,6 +16,8 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+
 namespace cynthia {
 namespace logic {
 
@@ -27,8 +29,10 @@ private:
   // The hash_ is defined as mutable, because its value is initialized to 0
   // in the constructor and then it can be changed in Basic::hash() to the
   // current hash (which is always the same for the given instance). The
-  // state of the instance does not change, so we define hash_ as mutable
-  mutable hash_t hash_; // This holds the hash value
+  // state of the instance does not change, so we define hash_ as mutable.
+  // It is atomic because shared nodes may be hashed by several threads;
+  // they all compute the same value, so relaxed ordering is enough.
+  mutable std::atomic<hash_t> hash_; // This holds the hash value
 
   /*!
   Calculates the hash of the given Cynthia class.
@@ -56,12 +60,13 @@ public:
       \return 64-bit integer value for the hash
   */
   inline hash_t hash() const {
-    if (hash_ == 0) {
-      auto hash_v = compute_hash_();
+    auto hash_v = hash_.load(std::memory_order_relaxed);
+    if (hash_v == 0) {
+      hash_v = compute_hash_();
       assert(hash_v != 0);
-      hash_ = hash_v;
+      hash_.store(hash_v, std::memory_order_relaxed);
     }
-    return hash_;
+    return hash_v;
   }
 };
 
@@ -16,41 +16,78 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <cynthia/logic/types.hpp>
 #include <cynthia/utils.hpp>
 #include <memory>
-#include <unordered_set>
+#include <mutex>
+#include <unordered_map>
 
 namespace cynthia {
 namespace logic {
 
 /*
- * A hash table for AST nodes based on STL unordered_set.
+ * A hash table for AST nodes based on STL unordered_map.
+ *
+ * The table is split in shards, selected by the hash of the node, each
+ * guarded by its own lock. Concurrent insertions are serialized only when
+ * they fall in the same shard, and the first node inserted among equal ones
+ * is the one returned to every thread.
+ *
+ * The table holds strong references, so nodes are not freed as soon as the
+ * rest of the program drops them; collect_garbage() sweeps them away.
  */
 class HashTable {
 private:
-  std::unordered_set<ast_ptr, utils::Deref::Hash, utils::Deref::Equal> m_table_;
+  static constexpr size_t nb_shards = 64;
+  // the value is the insertion stamp of the node
+  typedef std::unordered_map<ast_ptr, uint64_t, utils::Deref::Hash,
+                             utils::Deref::Equal>
+      shard_t;
+
+  struct Shard {
+    std::mutex mutex;
+    shard_t table;
+  };
+  std::array<Shard, nb_shards> m_shards_;
+  std::atomic<uint64_t> m_next_stamp_{0};
+
+  Shard& get_shard_(const AstNode& node);
+  // let the node compute what it caches, once it is known to be kept
+  static void on_insert_(const AstNode& node);
 
 public:
-  explicit HashTable() {
-    m_table_ =
-        std::unordered_set<ast_ptr, utils::Deref::Hash, utils::Deref::Equal>{};
-  }
+  HashTable() = default;
+  ~HashTable();
 
   template <typename T>
   std::shared_ptr<const T>
   insert_if_not_available(const std::shared_ptr<const T>& ptr) {
-    auto it = m_table_.find(ptr);
-    if (it == m_table_.end()) {
-      m_table_.insert(ptr);
-      return ptr;
-    } else {
-      return std::static_pointer_cast<const T>(*it);
+    auto& shard = get_shard_(*ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.table.find(ptr);
+    if (it == shard.table.end()) {
+      it = shard.table.emplace(ptr, m_next_stamp_++).first;
+      on_insert_(*ptr);
     }
+    return std::static_pointer_cast<const T>(it->first);
   }
 
-  size_t size() { return m_table_.size(); }
+  size_t size();
+
+  /*
+   * Remove the nodes that are referenced only by the table.
+   *
+   * Nodes are interned after their arguments, so scanning them from the
+   * newest to the oldest frees a whole unreferenced subformula in a single
+   * pass. All the shards are locked during the sweep.
+   *
+   * @return the number of removed nodes
+   */
+  size_t collect_garbage();
 };
 
 } // namespace logic
-} // namespace cynthia
\ No newline at end of file
+} // namespace cynthia
@@ -17,8 +17,11 @@
  */
 
 #include <algorithm>
+#include <cstdint>
+#include <cynthia/logic/atom_set.hpp>
 #include <cynthia/logic/base.hpp>
 #include <cynthia/logic/visitable.hpp>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -42,9 +45,66 @@ public:
   int compare_(const Comparable& o) const override;
 };
 
+/*
+ * Attributes of a formula that depend only on its structure. They are
+ * computed once, when the node is interned, from those of its arguments.
+ */
+struct FormulaAttributes {
+  // the atoms occurring in the formula, nullptr if there are none
+  atom_set_ptr atoms;
+  // number of nodes of the formula seen as a tree, saturated at the maximum
+  uint64_t tree_size = 1;
+  // maximum nesting of temporal operators
+  uint32_t temporal_depth = 0;
+  // whether the empty trace satisfies the formula
+  bool accepts_empty_trace = false;
+  // whether the formula is built from true, false and atoms with boolean
+  // connectives only
+  bool propositional = false;
+};
+
 class LTLfFormula : public AstNode {
+private:
+  // set by on_insert_()
+  mutable FormulaAttributes attributes_;
+
+protected:
+  static uint64_t saturating_add_(uint64_t a, uint64_t b) {
+    return a > std::numeric_limits<uint64_t>::max() - b
+               ? std::numeric_limits<uint64_t>::max()
+               : a + b;
+  }
+
+  // a temporal operator over the (already merged) attributes of its
+  // arguments
+  static FormulaAttributes set_temporal_(FormulaAttributes attributes,
+                                         bool accepts_empty_trace) {
+    attributes.accepts_empty_trace = accepts_empty_trace;
+    attributes.propositional = false;
+    attributes.temporal_depth += 1;
+    return attributes;
+  }
+
+  /*
+   * The attributes of this node, from those of its arguments. A node built
+   * by a make_* method that finds an equal node already interned is
+   * dropped, so only the interned one computes them.
+   */
+  virtual FormulaAttributes compute_attributes_() const { return {}; }
+  void on_insert_() const override { attributes_ = compute_attributes_(); }
+
 public:
   explicit LTLfFormula(Context& c) : AstNode(c) {}
+
+  const FormulaAttributes& attributes() const { return attributes_; }
+  bool accepts_empty_trace() const { return attributes_.accepts_empty_trace; }
+  bool is_propositional() const { return attributes_.propositional; }
+  uint64_t tree_size() const { return attributes_.tree_size; }
+  uint32_t temporal_depth() const { return attributes_.temporal_depth; }
+  const AtomSet& atoms() const {
+    static const AtomSet empty;
+    return attributes_.atoms ? *attributes_.atoms : empty;
+  }
 };
 
 class LTLfTrue : public LTLfFormula {
@@ -57,6 +117,13 @@ public:
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    FormulaAttributes result;
+    result.accepts_empty_trace = true;
+    return result;
+  }
 };
 
 class LTLfFalse : public LTLfFormula {
@@ -81,6 +148,13 @@ public:
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    FormulaAttributes result;
+    result.propositional = true;
+    return result;
+  }
 };
 
 class LTLfPropFalse : public LTLfFormula {
@@ -93,31 +167,58 @@ public:
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    FormulaAttributes result;
+    result.propositional = true;
+    return result;
+  }
 };
 
 class LTLfAtom : public LTLfFormula {
 public:
   const std::string name;
+  // the id of the name in the symbol table of the context
+  const size_t symbol_id;
   const static TypeID type_code_id = TypeID::t_LTLfAtom;
   LTLfAtom(Context& ctx, const std::string& name)
-      : LTLfFormula(ctx), name{name} {}
+      : LTLfFormula(ctx), name{name}, symbol_id{ctx.add_symbol(name)} {}
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    FormulaAttributes result;
+    result.propositional = true;
+    result.atoms = AtomSet::singleton(symbol_id);
+    return result;
+  }
 };
 
 class LTLfUnaryOp : public LTLfFormula {
 public:
   const ltlf_ptr arg;
   LTLfUnaryOp(Context& ctx, ltlf_ptr arg)
-      : LTLfFormula(ctx), arg{std::move(arg)} {}
+      : LTLfFormula(ctx), arg{std::move(arg)} {
+    // hash the argument now, so that hashing this node never recurses
+    this->arg->hash();
+  }
 
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = arg->attributes();
+    result.tree_size = saturating_add_(result.tree_size, 1);
+    return result;
+  }
 };
 
 class LTLfPropositionalNot : public LTLfUnaryOp {
@@ -125,7 +226,7 @@ public:
   const static TypeID type_code_id = TypeID::t_LTLfPropNot;
   LTLfPropositionalNot(Context& ctx, ltlf_ptr arg)
       : LTLfUnaryOp(ctx, std::move(arg)) {
-    if (!is_propositional(this->arg))
+    if (!logic::is_propositional(this->arg))
       throw std::invalid_argument(
           "PropositionalNot only accepts LTLfAtom as arguments.");
   }
@@ -135,6 +236,13 @@ public:
   inline atom_ptr get_atom() const {
     return std::static_pointer_cast<const LTLfAtom>(arg);
   }
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfUnaryOp::compute_attributes_();
+    result.accepts_empty_trace = false;
+    return result;
+  }
 };
 
 class LTLfNot : public LTLfUnaryOp {
@@ -144,6 +252,13 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfUnaryOp::compute_attributes_();
+    result.accepts_empty_trace = !arg->accepts_empty_trace();
+    return result;
+  }
 };
 
 class BooleanBinaryOp {
@@ -163,6 +278,7 @@ public:
       throw std::invalid_argument(
           "the number of arguments must not be less than two");
     }
+    hash_args_();
   }
 
   LTLfBinaryOp(Context& ctx, const set_ptr& args)
@@ -171,11 +287,51 @@ public:
       throw std::invalid_argument(
           "the number of arguments must not be less than two");
     }
+    hash_args_();
   }
 
   inline hash_t compute_hash_() const override;
   bool is_equal(const Comparable& o) const override;
   int compare_(const Comparable& o) const override;
+
+protected:
+  bool all_args_accept_empty_trace_() const {
+    return std::all_of(args.begin(), args.end(), [](const ltlf_ptr& arg) {
+      return arg->accepts_empty_trace();
+    });
+  }
+  bool any_arg_accepts_empty_trace_() const {
+    return std::any_of(args.begin(), args.end(), [](const ltlf_ptr& arg) {
+      return arg->accepts_empty_trace();
+    });
+  }
+
+  FormulaAttributes compute_attributes_() const override {
+    FormulaAttributes result;
+    std::vector<atom_set_ptr> atom_sets;
+    atom_sets.reserve(args.size());
+    result.propositional = true;
+    for (const auto& arg : args) {
+      const auto& arg_attributes = arg->attributes();
+      atom_sets.push_back(arg_attributes.atoms);
+      result.tree_size =
+          saturating_add_(result.tree_size, arg_attributes.tree_size);
+      result.temporal_depth =
+          std::max(result.temporal_depth, arg_attributes.temporal_depth);
+      result.propositional =
+          result.propositional and arg_attributes.propositional;
+    }
+    result.atoms = AtomSet::union_of(atom_sets);
+    return result;
+  }
+
+private:
+  // hash the arguments now, so that hashing this node never recurses
+  void hash_args_() const {
+    for (const auto& arg : args) {
+      arg->hash();
+    }
+  }
 };
 
 class LTLfCommutativeIdempotentBinaryOp : public LTLfBinaryOp {
@@ -204,6 +360,13 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfBinaryOp::compute_attributes_();
+    result.accepts_empty_trace = all_args_accept_empty_trace_();
+    return result;
+  }
 };
 
 class LTLfOr : public LTLfCommutativeIdempotentBinaryOp,
@@ -221,6 +384,13 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfBinaryOp::compute_attributes_();
+    result.accepts_empty_trace = any_arg_accepts_empty_trace_();
+    return result;
+  }
 };
 
 class LTLfImplies : public LTLfBinaryOp, public BooleanBinaryOp {
@@ -228,6 +398,14 @@ private:
   static inline bool implies_(bool b1, bool b2) {
     return utils::implies_(b1, b2);
   }
+  // a_1 -> ... -> a_n is ~a_1 | ... | ~a_{n-1} | a_n
+  bool accepts_empty_trace_() const {
+    return !std::all_of(args.begin(), args.end() - 1,
+                        [](const ltlf_ptr& arg) {
+                          return arg->accepts_empty_trace();
+                        }) or
+           args.back()->accepts_empty_trace();
+  }
 
 public:
   const static TypeID type_code_id = TypeID::t_LTLfImplies;
@@ -238,6 +416,13 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfBinaryOp::compute_attributes_();
+    result.accepts_empty_trace = accepts_empty_trace_();
+    return result;
+  }
 };
 
 class LTLfEquivalent : public LTLfBinaryOp, public BooleanBinaryOp {
@@ -249,13 +434,21 @@ private:
 public:
   const static TypeID type_code_id = TypeID::t_LTLfEquivalent;
   LTLfEquivalent(Context& ctx, vec_ptr args)
-      : LTLfBinaryOp(ctx, utils::sort(std::move(args))),
+      : LTLfBinaryOp(ctx, utils::sort(std::move(args), utils::Deref::Less())),
         BooleanBinaryOp(equivalent_) {}
   LTLfEquivalent(Context& ctx, const set_ptr& args)
       : LTLfBinaryOp(ctx, args), BooleanBinaryOp(equivalent_) {}
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfBinaryOp::compute_attributes_();
+    result.accepts_empty_trace =
+        all_args_accept_empty_trace_() or !any_arg_accepts_empty_trace_();
+    return result;
+  }
 };
 
 class LTLfXor : public LTLfBinaryOp, public BooleanBinaryOp {
@@ -265,13 +458,21 @@ private:
 public:
   const static TypeID type_code_id = TypeID::t_LTLfXor;
   LTLfXor(Context& ctx, vec_ptr args)
-      : LTLfBinaryOp(ctx, utils::sort(std::move(args))), BooleanBinaryOp(xor_) {
-  }
+      : LTLfBinaryOp(ctx, utils::sort(std::move(args), utils::Deref::Less())),
+        BooleanBinaryOp(xor_) {}
   LTLfXor(Context& ctx, const set_ptr& args)
       : LTLfBinaryOp(ctx, args), BooleanBinaryOp(xor_) {}
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    auto result = LTLfBinaryOp::compute_attributes_();
+    result.accepts_empty_trace =
+        any_arg_accepts_empty_trace_() and !all_args_accept_empty_trace_();
+    return result;
+  }
 };
 
 class LTLfNext : public LTLfUnaryOp {
@@ -281,15 +482,26 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfUnaryOp::compute_attributes_(), false);
+  }
 };
 
 class LTLfWeakNext : public LTLfUnaryOp {
 public:
   const static TypeID type_code_id = TypeID::t_LTLfWeakNext;
-  LTLfWeakNext(Context& ctx, ltlf_ptr arg) : LTLfUnaryOp(ctx, std::move(arg)) {}
+  LTLfWeakNext(Context& ctx, ltlf_ptr arg)
+      : LTLfUnaryOp(ctx, std::move(arg)) {}
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfUnaryOp::compute_attributes_(), true);
+  }
 };
 
 class LTLfUntil : public LTLfBinaryOp {
@@ -300,6 +512,11 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfBinaryOp::compute_attributes_(), false);
+  }
 };
 
 class LTLfRelease : public LTLfBinaryOp {
@@ -310,6 +527,11 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfBinaryOp::compute_attributes_(), true);
+  }
 };
 
 class LTLfEventually : public LTLfUnaryOp {
@@ -320,6 +542,11 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfUnaryOp::compute_attributes_(), false);
+  }
 };
 
 class LTLfAlways : public LTLfUnaryOp {
@@ -329,6 +556,11 @@ public:
 
   void accept(Visitor& visitor) const override;
   inline TypeID get_type_code() const override;
+
+protected:
+  FormulaAttributes compute_attributes_() const override {
+    return set_temporal_(LTLfUnaryOp::compute_attributes_(), true);
+  }
 };
 
 inline bool is_propositional(const ltlf_ptr& arg) {
@@ -346,6 +578,8 @@ inline hash_t LTLfFalse::compute_hash_() const { return type_code_id; }
 inline hash_t LTLfPropTrue::compute_hash_() const { return type_code_id; }
 inline hash_t LTLfPropFalse::compute_hash_() const { return type_code_id; }
 inline hash_t LTLfAtom::compute_hash_() const {
+  // the name, not the symbol id: atoms of different contexts with the same
+  // name are equal, so they must have the same hash
   hash_t result = type_code_id;
   hash_combine(result, name);
   return result;
@@ -0,0 +1,255 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cynthia/logic/dispatch.hpp>
+#include <cynthia/logic/utils.hpp>
+#include <cynthia/logic/visitor.hpp>
+
+namespace cynthia {
+namespace logic {
+
+struct CacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t size = 0;
+};
+
+/*
+ * Cache of the results of a visitor, indexed by node.
+ *
+ * The cache holds a reference to each node, so a node address cannot be
+ * reused while it is in the cache.
+ */
+template <typename ResultType> class ResultCache {
+private:
+  struct Entry {
+    ltlf_ptr formula;
+    ResultType result;
+  };
+  std::unordered_map<const LTLfFormula*, Entry> entries_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+public:
+  /*
+   * Return the cached result of the formula, or nullptr if there is none.
+   */
+  const ResultType* find(const LTLfFormula& formula) {
+    auto it = entries_.find(&formula);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    ++hits_;
+    return &it->second.result;
+  }
+
+  /*
+   * Same as find(), but without updating the statistics.
+   */
+  const ResultType* peek(const LTLfFormula& formula) const {
+    auto it = entries_.find(&formula);
+    return it == entries_.end() ? nullptr : &it->second.result;
+  }
+
+  /*
+   * Store a newly computed result; each insertion counts as a miss.
+   */
+  void insert(const LTLfFormula& formula, const ResultType& result) {
+    ++misses_;
+    entries_.emplace(&formula, Entry{formula.shared_from_this(), result});
+  }
+
+  template <typename Function> void for_each_result(Function function) const {
+    for (const auto& entry : entries_) {
+      function(entry.second.result);
+    }
+  }
+
+  CacheStats stats() const {
+    return CacheStats{hits_, misses_, entries_.size()};
+  }
+
+  void clear() {
+    entries_.clear();
+    hits_ = 0;
+    misses_ = 0;
+  }
+};
+
+/*
+ * Run a post-order traversal of the tasks reachable from root, with an
+ * explicit stack instead of recursion.
+ *
+ * for_each_dependency(task, push) calls push on the tasks whose results
+ * are needed to compute task; compute(task) computes and stores the result
+ * of task, once its dependencies are done. Tasks for which is_done holds
+ * are skipped. Memoizing visitors use it to fill their cache bottom-up, so
+ * that the recursion depth of their visit methods does not grow with the
+ * depth of the formula.
+ */
+template <typename Task, typename IsDone, typename ForEachDependency,
+          typename Compute>
+void compute_bottom_up(const Task& root, IsDone is_done,
+                       ForEachDependency for_each_dependency,
+                       Compute compute) {
+  std::vector<std::pair<Task, bool>> stack{{root, false}};
+  while (!stack.empty()) {
+    Task task = stack.back().first;
+    if (is_done(task)) {
+      stack.pop_back();
+    } else if (stack.back().second) {
+      stack.pop_back();
+      compute(task);
+    } else {
+      stack.back().second = true;
+      for_each_dependency(task, [&stack, &is_done](const Task& dependency) {
+        if (!is_done(dependency)) {
+          stack.emplace_back(dependency, false);
+        }
+      });
+    }
+  }
+}
+
+/*
+ * Base class for visitors that compute a value for each node.
+ *
+ * The result of every visited node is cached, so shared subformulas are
+ * visited once per visitor instance rather than once per occurrence. Since
+ * the context hash-conses the nodes, this makes the traversal linear in the
+ * size of the DAG instead of the size of the tree.
+ *
+ * Subclasses set `result` in their visit methods and recurse through
+ * apply(). Before a node is visited, the results it depends on are
+ * computed iteratively (see compute_bottom_up()), so that very deep
+ * formulas do not overflow the stack. for_each_dependency_() lists them:
+ * by default, every argument in this visitor; subclasses must override it
+ * if they do not apply() themselves to all the arguments of a node, and
+ * can list results of another visitor with the same result type that they
+ * delegate to. Visitors whose results are reference counted can override
+ * retain_result_(), which is called every time a result is returned from
+ * the cache; the cache keeps the reference of the computed value.
+ */
+template <typename ResultType> class MemoizingVisitor : public Visitor {
+protected:
+  typedef std::function<void(MemoizingVisitor&, const LTLfFormula&)>
+      DependencyFunction;
+
+  ResultType result{};
+  ResultCache<ResultType> cache_;
+
+  virtual void retain_result_(const ResultType&) {}
+
+  virtual void for_each_dependency_(const LTLfFormula& formula,
+                                    const DependencyFunction& function) {
+    for_each_argument(formula,
+                      [this, &function](const LTLfFormula& argument) {
+                        function(*this, argument);
+                      });
+  }
+
+public:
+  ResultType apply(const LTLfFormula& formula) {
+    if (auto cached = cache_.find(formula)) {
+      retain_result_(*cached);
+      return *cached;
+    }
+    typedef std::pair<MemoizingVisitor*, const LTLfFormula*> Task;
+    compute_bottom_up(
+        Task{this, &formula},
+        [](const Task& task) {
+          return task.first->cache_.peek(*task.second) != nullptr;
+        },
+        [](const Task& task, auto push) {
+          task.first->for_each_dependency_(
+              *task.second,
+              [&push](MemoizingVisitor& visitor, const LTLfFormula& node) {
+                push(Task{&visitor, &node});
+              });
+        },
+        [](const Task& task) {
+          auto& visitor = *task.first;
+          task.second->accept(visitor);
+          visitor.cache_.insert(*task.second, visitor.result);
+        });
+    auto value = *cache_.peek(formula);
+    retain_result_(value);
+    return value;
+  }
+
+  CacheStats cache_stats() const { return cache_.stats(); }
+  void clear_cache() { cache_.clear(); }
+};
+
+/*
+ * Same as MemoizingVisitor, but the nodes are dispatched statically to
+ * Derived (see dispatch()), whose visit methods return their result
+ * instead of storing it. Derived can hide retain_result_() to handle
+ * reference counted results, and for_each_dependency_() to restrict the
+ * subformulas computed ahead of a visit.
+ */
+template <typename Derived, typename ResultType>
+class StaticMemoizingVisitor {
+protected:
+  ResultCache<ResultType> cache_;
+
+  void retain_result_(const ResultType&) {}
+
+  template <typename Function>
+  void for_each_dependency_(const LTLfFormula& formula, Function function) {
+    for_each_argument(formula, function);
+  }
+
+public:
+  ResultType apply(const LTLfFormula& formula) {
+    auto& self = static_cast<Derived&>(*this);
+    if (auto cached = cache_.find(formula)) {
+      self.retain_result_(*cached);
+      return *cached;
+    }
+    compute_bottom_up(
+        &formula,
+        [this](const LTLfFormula* node) {
+          return cache_.peek(*node) != nullptr;
+        },
+        [&self](const LTLfFormula* node, auto push) {
+          self.for_each_dependency_(
+              *node, [&push](const LTLfFormula& dependency) {
+                push(&dependency);
+              });
+        },
+        [this, &self](const LTLfFormula* node) {
+          cache_.insert(*node, dispatch(*node, self));
+        });
+    ResultType value = *cache_.peek(formula);
+    self.retain_result_(value);
+    return value;
+  }
+
+  CacheStats cache_stats() const { return cache_.stats(); }
+  void clear_cache() { cache_.clear(); }
+};
+
+} // namespace logic
+} // namespace cynthia
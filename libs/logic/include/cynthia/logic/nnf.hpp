@@ -19,16 +19,23 @@
 #include <cstdint>
 #include <memory>
 
+#include <cynthia/logic/duality.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
 #include <cynthia/logic/utils.hpp>
-#include <cynthia/logic/visitor.hpp>
 
 namespace cynthia {
 namespace logic {
 
-class NNFTransformer : public Visitor {
-public:
-  ltlf_ptr result;
+class NNFTransformer : public MemoizingVisitor<ltlf_ptr> {
+private:
+  // shares the negations pushed down across the whole transformation
+  NegationTransformer negation_transformer_{this};
+
+protected:
+  void for_each_dependency_(const LTLfFormula& formula,
+                            const DependencyFunction& function) override;
 
+public:
   void visit(const LTLfTrue&) override;
   void visit(const LTLfFalse&) override;
   void visit(const LTLfPropTrue&) override;
@@ -47,8 +54,6 @@ public:
   void visit(const LTLfRelease&) override;
   void visit(const LTLfEventually&) override;
   void visit(const LTLfAlways&) override;
-
-  ltlf_ptr apply(const LTLfFormula& f);
 };
 
 ltlf_ptr to_nnf(const LTLfFormula& f);
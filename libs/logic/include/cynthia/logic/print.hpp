@@ -18,6 +18,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <cynthia/logic/utils.hpp>
 #include <cynthia/logic/visitor.hpp>
@@ -27,10 +29,15 @@ namespace logic {
 
 class PrintVisitor : public Visitor {
 private:
-  void binary_op_to_string(const LTLfBinaryOp& formula,
-                           const std::string& op_symbol);
-  void unary_op_to_string(const LTLfUnaryOp& formula,
-                          const std::string& op_symbol);
+  // either a formula still to print, or a piece of text
+  struct Token {
+    const LTLfFormula* formula;
+    const char* text;
+  };
+  std::vector<Token> stack_;
+
+  void binary_op_to_string(const LTLfBinaryOp& formula, const char* op_symbol);
+  void unary_op_to_string(const LTLfUnaryOp& formula, const char* op_symbol);
 
 public:
   std::string result;
@@ -0,0 +1,66 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include <cynthia/logic/base.hpp>
+#include <cynthia/logic/types.hpp>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * Binary format of a formula, to load big specifications without parsing
+ * them. The nodes of the DAG are written once each, in post-order, so that
+ * a node only refers to nodes before it:
+ *
+ *   magic      "CYNLTLF" followed by the format version byte
+ *   symbols    count, then length and bytes of each atom name
+ *   nodes      count, then for each node its kind byte and
+ *                - atoms: the index of the name in the symbols
+ *                - unary operators: the index of the argument
+ *                - n-ary operators: the count and the indices of the args
+ *   root       the index of the root node
+ *
+ * All the integers are unsigned LEB128 varints.
+ */
+
+void write_binary(const LTLfFormula& formula, std::ostream& out);
+void save_binary(const LTLfFormula& formula, const std::string& filename);
+
+/**
+ * Rebuild a formula from its binary format.
+ * @throw std::runtime_error if the data is not a valid formula
+ */
+ltlf_ptr read_binary(Context& context, const char* data, size_t size);
+
+/**
+ * Rebuild a formula from a binary file, mapped in memory.
+ * @throw std::runtime_error if the file cannot be read or is not valid
+ */
+ltlf_ptr load_binary(Context& context, const std::string& filename);
+
+/**
+ * @return whether the file starts with the magic of the binary format
+ */
+bool is_binary_file(const std::string& filename);
+
+} // namespace logic
+} // namespace cynthia
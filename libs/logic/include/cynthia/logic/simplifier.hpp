@@ -0,0 +1,99 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cynthia/logic/memoizing_visitor.hpp>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * The rewriting rules applied by the Simplifier. All the rules are
+ * equivalences over finite traces, the empty trace included.
+ */
+struct SimplifierOptions {
+  // ff, tt and true/false in the arguments of the operators, e.g.
+  // X[!]ff = ff, a & !a = ff, a | !a = true, true & X a = X a
+  bool constant_propagation = true;
+  // F F f = F f, G G f = G f, f U (f U g) = f U g, f R (f R g) = f R g
+  bool temporal_absorption = true;
+  // X f & X g = X (f & g), and the like for the other combinations of
+  // X[!] and WX, so that fewer next subformulas end up in the closure
+  bool next_distribution = true;
+  // f & (f | g) = f and f | (f & g) = f: a disjunction in a conjunction is
+  // removed when another argument is one of its disjuncts, or a
+  // disjunction of a subset of its disjuncts; dually for disjunctions
+  bool subsumption = true;
+
+  static SimplifierOptions none() {
+    return SimplifierOptions{false, false, false, false};
+  }
+
+  bool any() const {
+    return constant_propagation or temporal_absorption or
+           next_distribution or subsumption;
+  }
+};
+
+/*
+ * Rewrite a formula in negation normal form into an equivalent, and
+ * usually smaller, formula in negation normal form. The closure of the
+ * formula, and so the number of state variables of the synthesis, shrinks
+ * accordingly.
+ *
+ * Formulas not in negation normal form are simplified as well, but the
+ * negations are not pushed down.
+ */
+class Simplifier : public MemoizingVisitor<ltlf_ptr> {
+private:
+  const SimplifierOptions options_;
+
+  ltlf_ptr simplify_connective_(const LTLfBinaryOp& formula, bool is_and);
+  ltlf_ptr make_next_(Context& context, const ltlf_ptr& arg, bool strong);
+  void distribute_nexts_(Context& context, vec_ptr& args, bool is_and);
+  bool propagate_constants_(Context& context, vec_ptr& args, bool is_and);
+  void remove_subsumed_(vec_ptr& args, bool is_and);
+
+public:
+  explicit Simplifier(const SimplifierOptions& options = SimplifierOptions{})
+      : options_{options} {}
+
+  void visit(const LTLfTrue&) override;
+  void visit(const LTLfFalse&) override;
+  void visit(const LTLfPropTrue&) override;
+  void visit(const LTLfPropFalse&) override;
+  void visit(const LTLfAtom&) override;
+  void visit(const LTLfNot&) override;
+  void visit(const LTLfPropositionalNot&) override;
+  void visit(const LTLfAnd&) override;
+  void visit(const LTLfOr&) override;
+  void visit(const LTLfImplies&) override;
+  void visit(const LTLfEquivalent&) override;
+  void visit(const LTLfXor&) override;
+  void visit(const LTLfNext&) override;
+  void visit(const LTLfWeakNext&) override;
+  void visit(const LTLfUntil&) override;
+  void visit(const LTLfRelease&) override;
+  void visit(const LTLfEventually&) override;
+  void visit(const LTLfAlways&) override;
+};
+
+ltlf_ptr simplify_formula(const LTLfFormula& f,
+                          const SimplifierOptions& options = {});
+
+} // namespace logic
+} // namespace cynthia
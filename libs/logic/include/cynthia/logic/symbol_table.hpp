@@ -0,0 +1,88 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * Interns atom names into dense integer ids, assigned in order of first
+ * insertion. Ids can be used to index flat arrays instead of looking up names.
+ *
+ * All the operations are thread-safe. Names are stored in a deque, so the
+ * references returned by get_name() stay valid while other names are added.
+ */
+class SymbolTable {
+private:
+  mutable std::mutex mutex_;
+  std::deque<std::string> from_id_to_name_;
+  std::unordered_map<std::string, size_t> from_name_to_id_;
+
+public:
+  /**
+   * Add a name to the table, but only if it is not already present.
+   * @param name the name of the symbol
+   * @return the id of the symbol
+   */
+  size_t add(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = from_name_to_id_.find(name);
+    if (it != from_name_to_id_.end()) {
+      return it->second;
+    }
+    auto id = from_id_to_name_.size();
+    from_id_to_name_.push_back(name);
+    from_name_to_id_.emplace(name, id);
+    return id;
+  }
+
+  bool contains(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return from_name_to_id_.find(name) != from_name_to_id_.end();
+  }
+
+  size_t get_id(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = from_name_to_id_.find(name);
+    if (it == from_name_to_id_.end()) {
+      throw std::invalid_argument("symbol " + name + " not found");
+    }
+    return it->second;
+  }
+
+  const std::string& get_name(size_t id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= from_id_to_name_.size()) {
+      throw std::invalid_argument("invalid symbol id");
+    }
+    return from_id_to_name_[id];
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return from_id_to_name_.size();
+  }
+};
+
+} // namespace logic
+} // namespace cynthia
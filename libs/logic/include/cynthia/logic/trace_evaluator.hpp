@@ -0,0 +1,112 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <cynthia/logic/ltlf.hpp>
+
+namespace cynthia {
+namespace logic {
+
+/*
+ * A finite trace: for each instant, the symbol ids (see Context::symbols())
+ * of the atoms that hold at that instant.
+ */
+typedef std::vector<std::vector<size_t>> trace_t;
+
+/*
+ * Evaluate a formula over many finite traces.
+ *
+ * The formula is compiled once into a flat post-order program over its
+ * distinct nodes. Traces are then evaluated batch_size at a time, one bit
+ * per trace, going through the instants backwards: the value of every node
+ * at an instant only depends on the values of its arguments at the same
+ * instant and on the values at the next instant.
+ *
+ * The evaluator is immutable once built, so it can be shared by several
+ * threads.
+ */
+class TraceEvaluator {
+public:
+  static constexpr size_t nb_words = 4;
+  static constexpr size_t batch_size = 64 * nb_words;
+
+  explicit TraceEvaluator(const LTLfFormula& formula);
+
+  bool evaluate(const trace_t& trace) const;
+  std::vector<bool> evaluate(const std::vector<trace_t>& traces) const;
+
+  /**
+   * @return the number of instructions of the compiled program
+   */
+  size_t program_size() const { return program_.size(); }
+
+private:
+  typedef std::array<uint64_t, nb_words> Lanes;
+
+  enum class Op : uint8_t {
+    True,
+    False,
+    PropTrue,
+    PropFalse,
+    Atom,
+    PropNot,
+    Not,
+    And,
+    Or,
+    Implies,
+    Equivalent,
+    Xor,
+    Next,
+    WeakNext,
+    Until,
+    Release,
+    Eventually,
+    Always
+  };
+
+  // the arguments of an instruction are operands_[first, first + count),
+  // except for atoms, where first is the index of the atom in atom_symbols_
+  struct Instruction {
+    Op op;
+    uint32_t first;
+    uint32_t count;
+  };
+
+  std::vector<Instruction> program_;
+  std::vector<uint32_t> operands_;
+  uint32_t root_ = 0;
+  // the value of each instruction on the empty (suffix of a) trace
+  std::vector<bool> empty_values_;
+  std::vector<size_t> atom_symbols_;
+  // from symbol id to index in atom_symbols_, or no_atom
+  std::vector<uint32_t> symbol_to_atom_;
+
+  static constexpr uint32_t no_atom = UINT32_MAX;
+
+  uint32_t add_instruction_(Op op, const std::vector<uint32_t>& arguments);
+  void compute_empty_values_();
+  // evaluate at most batch_size traces, and store the results from offset
+  void evaluate_batch_(const std::vector<const trace_t*>& traces,
+                       std::vector<bool>& results, size_t offset) const;
+};
+
+} // namespace logic
+} // namespace cynthia
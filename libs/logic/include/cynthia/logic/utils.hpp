@@ -31,5 +31,52 @@ inline ltlf_ptr forward_call_to_arguments(const LTLfBinaryOp& formula,
                  mapping_function);
   return factory_function(new_container);
 }
+
+/*
+ * Whether the formula is an and, or, implies, equivalent or xor.
+ */
+inline bool is_boolean_connective(const LTLfFormula& formula) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfAnd:
+  case TypeID::t_LTLfOr:
+  case TypeID::t_LTLfImplies:
+  case TypeID::t_LTLfEquivalent:
+  case TypeID::t_LTLfXor:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/*
+ * Call the function on each direct argument of the formula, in order.
+ * Leaves (constants and atoms) have no arguments.
+ */
+template <typename Function>
+inline void for_each_argument(const LTLfFormula& formula, Function function) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfPropNot:
+  case TypeID::t_LTLfNot:
+  case TypeID::t_LTLfNext:
+  case TypeID::t_LTLfWeakNext:
+  case TypeID::t_LTLfEventually:
+  case TypeID::t_LTLfAlways:
+    function(*static_cast<const LTLfUnaryOp&>(formula).arg);
+    break;
+  case TypeID::t_LTLfAnd:
+  case TypeID::t_LTLfOr:
+  case TypeID::t_LTLfImplies:
+  case TypeID::t_LTLfEquivalent:
+  case TypeID::t_LTLfXor:
+  case TypeID::t_LTLfUntil:
+  case TypeID::t_LTLfRelease:
+    for (const auto& arg : static_cast<const LTLfBinaryOp&>(formula).args) {
+      function(*arg);
+    }
+    break;
+  default:
+    break;
+  }
+}
 } // namespace logic
 } // namespace cynthia
\ No newline at end of file
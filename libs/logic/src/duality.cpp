@@ -45,7 +45,8 @@ void NegationTransformer::visit(const LTLfAtom& formula) {
 }
 void NegationTransformer::visit(const LTLfNot& formula) {
   // nnf(~~f) = nnf(f)
-  result = to_nnf(*formula.arg);
+  result = nnf_transformer_ ? nnf_transformer_->apply(*formula.arg)
+                            : to_nnf(*formula.arg);
 }
 void NegationTransformer::visit(const LTLfPropositionalNot& formula) {
   //  nnf(~!a) = a | end
@@ -59,14 +60,14 @@ void NegationTransformer::visit(const LTLfPropositionalNot& formula) {
 void NegationTransformer::visit(const LTLfAnd& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_or(container);
       });
 }
 void NegationTransformer::visit(const LTLfOr& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_and(container);
       });
 }
@@ -91,14 +92,14 @@ void NegationTransformer::visit(const LTLfWeakNext& formula) {
 void NegationTransformer::visit(const LTLfUntil& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_release(container);
       });
 }
 void NegationTransformer::visit(const LTLfRelease& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_until(container);
       });
 }
@@ -109,9 +110,41 @@ void NegationTransformer::visit(const LTLfAlways& formula) {
   result = formula.ctx().make_eventually(apply(*formula.arg));
 }
 
-ltlf_ptr NegationTransformer::apply(const LTLfFormula& f) {
-  f.accept(*this);
-  return result;
+void NegationTransformer::for_each_dependency_(
+    const LTLfFormula& formula, const DependencyFunction& function) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfPropNot:
+    break;
+  case TypeID::t_LTLfNot:
+    // nnf(~~f) = nnf(f)
+    if (nnf_transformer_) {
+      function(*nnf_transformer_, *static_cast<const LTLfNot&>(formula).arg);
+    }
+    break;
+  case TypeID::t_LTLfImplies: {
+    // nnf(~(a -> b)) = nnf(~~a & ~b)
+    const auto& args = static_cast<const LTLfImplies&>(formula).args;
+    if (nnf_transformer_) {
+      for (auto it = args.begin(); it != args.end() - 1; ++it) {
+        function(*nnf_transformer_, **it);
+      }
+    }
+    function(*this, *args.back());
+    break;
+  }
+  case TypeID::t_LTLfEquivalent:
+  case TypeID::t_LTLfXor:
+    // the simplified formula has the arguments in both polarities
+    for_each_argument(formula, [this, &function](const LTLfFormula& argument) {
+      function(*this, argument);
+      if (nnf_transformer_) {
+        function(*nnf_transformer_, argument);
+      }
+    });
+    break;
+  default:
+    MemoizingVisitor::for_each_dependency_(formula, function);
+  }
 }
 
 ltlf_ptr apply_negation(const LTLfFormula& f) {
@@ -0,0 +1,98 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cynthia/logic/base.hpp>
+#include <cynthia/logic/hashtable.hpp>
+#include <vector>
+
+namespace cynthia {
+namespace logic {
+
+HashTable::Shard& HashTable::get_shard_(const AstNode& node) {
+  // spread the hash bits, since the shard and the bucket inside the shard
+  // are both selected from the same hash.
+  auto mixed = static_cast<uint64_t>(node.hash()) * 0x9E3779B97F4A7C15ull;
+  return m_shards_[(mixed >> 32) % nb_shards];
+}
+
+void HashTable::on_insert_(const AstNode& node) { node.on_insert_(); }
+
+HashTable::~HashTable() {
+  // free the nodes from the newest to the oldest: the arguments of a node
+  // are still alive when it is freed, so the destructors of a very deep
+  // formula do not recurse into each other.
+  std::vector<std::pair<uint64_t, ast_ptr>> nodes;
+  for (auto& shard : m_shards_) {
+    for (const auto& entry : shard.table) {
+      nodes.emplace_back(entry.second, entry.first);
+    }
+    shard.table.clear();
+  }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const std::pair<uint64_t, ast_ptr>& a,
+               const std::pair<uint64_t, ast_ptr>& b) {
+              return a.first < b.first;
+            });
+  while (!nodes.empty()) {
+    nodes.pop_back();
+  }
+}
+
+size_t HashTable::size() {
+  size_t result = 0;
+  for (auto& shard : m_shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result += shard.table.size();
+  }
+  return result;
+}
+
+size_t HashTable::collect_garbage() {
+  std::array<std::unique_lock<std::mutex>, nb_shards> locks;
+  for (size_t i = 0; i < nb_shards; ++i) {
+    locks[i] = std::unique_lock<std::mutex>(m_shards_[i].mutex);
+  }
+
+  // iterators stay valid: nothing is inserted while the shards are locked,
+  // and erasing an element only invalidates the iterators to it.
+  struct Entry {
+    uint64_t stamp;
+    shard_t* table;
+    shard_t::iterator it;
+  };
+  std::vector<Entry> entries;
+  for (auto& shard : m_shards_) {
+    for (auto it = shard.table.begin(); it != shard.table.end(); ++it) {
+      entries.push_back(Entry{it->second, &shard.table, it});
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.stamp > b.stamp; });
+
+  size_t result = 0;
+  for (const auto& entry : entries) {
+    if (entry.it->first.use_count() == 1) {
+      entry.table->erase(entry.it);
+      ++result;
+    }
+  }
+  return result;
+}
+
+} // namespace logic
+} // namespace cynthia
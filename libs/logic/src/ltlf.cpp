@@ -17,6 +17,7 @@
 
 #include <cynthia/logic/ltlf.hpp>
 #include <cynthia/logic/visitor.hpp>
+#include <utility>
 #include <vector>
 
 namespace cynthia {
@@ -66,34 +67,157 @@ int LTLfPropFalse::compare_(const Comparable& o) const {
 }
 
 bool LTLfAtom::is_equal(const Comparable& o) const {
-  return is_a<LTLfAtom>(o) and name == dynamic_cast<const LTLfAtom&>(o).name;
+  if (!is_a<LTLfAtom>(o))
+    return false;
+  const auto& other = dynamic_cast<const LTLfAtom&>(o);
+  // symbol ids are only comparable within the same context
+  if (&ctx() == &other.ctx())
+    return symbol_id == other.symbol_id;
+  return name == other.name;
 }
 int LTLfAtom::compare_(const Comparable& o) const {
   assert(is_a<LTLfAtom>(o));
-  auto n1 = this->name;
-  auto n2 = dynamic_cast<const LTLfAtom&>(o).name;
+  const auto& other = dynamic_cast<const LTLfAtom&>(o);
+  if (&ctx() == &other.ctx() and symbol_id == other.symbol_id)
+    return 0;
+  const auto& n1 = this->name;
+  const auto& n2 = other.name;
   return n1 == n2 ? 0 : n1 < n2 ? -1 : 1;
 }
 
+// Formulas are compared with an explicit stack of the pairs of subformulas
+// left to compare, so that comparing deep formulas does not recurse once
+// per operator. The pairs are visited depth-first, left to right.
+//
+// Binary operators are ordered by number of arguments, then by hash, and
+// only then by their arguments: comparing two distinct nodes of a context
+// does not walk their subformulas, which keeps the sorted containers of
+// deep formulas (e.g. the closure) from comparing whole chains.
+namespace {
+typedef std::vector<std::pair<const Comparable*, const Comparable*>>
+    compare_stack_t;
+
+bool is_unary_op(const Comparable& node) {
+  switch (node.get_type_code()) {
+  case TypeID::t_LTLfPropNot:
+  case TypeID::t_LTLfNot:
+  case TypeID::t_LTLfNext:
+  case TypeID::t_LTLfWeakNext:
+  case TypeID::t_LTLfEventually:
+  case TypeID::t_LTLfAlways:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool is_binary_op(const Comparable& node) {
+  switch (node.get_type_code()) {
+  case TypeID::t_LTLfAnd:
+  case TypeID::t_LTLfOr:
+  case TypeID::t_LTLfImplies:
+  case TypeID::t_LTLfEquivalent:
+  case TypeID::t_LTLfXor:
+  case TypeID::t_LTLfUntil:
+  case TypeID::t_LTLfRelease:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// the order of two binary operators of the same type that does not depend
+// on their arguments; 0 if they have the same number of arguments and the
+// same hash
+int compare_binary_ops(const LTLfBinaryOp& left, const LTLfBinaryOp& right) {
+  if (left.args.size() != right.args.size())
+    return left.args.size() < right.args.size() ? -1 : 1;
+  auto left_hash = left.hash();
+  auto right_hash = right.hash();
+  if (left_hash != right_hash)
+    return left_hash < right_hash ? -1 : 1;
+  return 0;
+}
+
+// push the pairs of arguments of two operators of the same type and arity,
+// the first ones on top
+void push_arguments(const Comparable& left, const Comparable& right,
+                    compare_stack_t& stack) {
+  if (is_unary_op(left)) {
+    stack.emplace_back(static_cast<const LTLfUnaryOp&>(left).arg.get(),
+                       static_cast<const LTLfUnaryOp&>(right).arg.get());
+    return;
+  }
+  const auto& left_args = static_cast<const LTLfBinaryOp&>(left).args;
+  const auto& right_args = static_cast<const LTLfBinaryOp&>(right).args;
+  for (size_t i = left_args.size(); i-- > 0;) {
+    stack.emplace_back(left_args[i].get(), right_args[i].get());
+  }
+}
+
+bool deep_equal(const Comparable& left, const Comparable& right) {
+  compare_stack_t stack{{&left, &right}};
+  while (!stack.empty()) {
+    auto [l, r] = stack.back();
+    stack.pop_back();
+    if (l == r)
+      continue;
+    if (l->get_type_code() != r->get_type_code())
+      return false;
+    if (is_binary_op(*l)) {
+      if (compare_binary_ops(static_cast<const LTLfBinaryOp&>(*l),
+                             static_cast<const LTLfBinaryOp&>(*r)) != 0)
+        return false;
+    } else if (!is_unary_op(*l)) {
+      if (!l->is_equal(*r))
+        return false;
+      continue;
+    }
+    push_arguments(*l, *r, stack);
+  }
+  return true;
+}
+
+int deep_compare(const Comparable& left, const Comparable& right) {
+  compare_stack_t stack{{&left, &right}};
+  while (!stack.empty()) {
+    auto [l, r] = stack.back();
+    stack.pop_back();
+    if (l == r)
+      continue;
+    if (l->get_type_code() != r->get_type_code())
+      return l->compare(*r);
+    if (is_binary_op(*l)) {
+      auto result = compare_binary_ops(static_cast<const LTLfBinaryOp&>(*l),
+                                       static_cast<const LTLfBinaryOp&>(*r));
+      if (result != 0)
+        return result;
+    } else if (!is_unary_op(*l)) {
+      auto result = l->compare_(*r);
+      if (result != 0)
+        return result;
+      continue;
+    }
+    push_arguments(*l, *r, stack);
+  }
+  return 0;
+}
+} // namespace
+
 bool LTLfUnaryOp::is_equal(const Comparable& o) const {
-  return get_type_code() == o.get_type_code() and
-         arg->is_equal(*dynamic_cast<const LTLfUnaryOp&>(o).arg);
+  return deep_equal(*this, o);
 }
 int LTLfUnaryOp::compare_(const Comparable& o) const {
   assert(get_type_code() == o.get_type_code());
-  return this->arg->compare(*dynamic_cast<const LTLfUnaryOp&>(o).arg);
+  return deep_compare(*this, o);
 }
 
 bool LTLfBinaryOp::is_equal(const Comparable& o) const {
-  return get_type_code() == o.get_type_code() and
-         std::equal(args.begin(), args.end(),
-                    dynamic_cast<const LTLfBinaryOp&>(o).args.begin(),
-                    utils::Deref::Equal());
+  return deep_equal(*this, o);
 }
 int LTLfBinaryOp::compare_(const Comparable& o) const {
   assert(this->get_type_code() == o.get_type_code());
-  return utils::ordered_compare(this->args,
-                                dynamic_cast<const LTLfBinaryOp&>(o).args);
+  return deep_compare(*this, o);
 }
 
 ltlf_ptr simplify(const LTLfImplies& formula) {
@@ -43,7 +43,7 @@ void NNFTransformer::visit(const LTLfAtom& formula) {
 }
 
 void NNFTransformer::visit(const LTLfNot& formula) {
-  result = apply_negation(*formula.arg);
+  result = negation_transformer_.apply(*formula.arg);
 }
 
 void NNFTransformer::visit(const LTLfPropositionalNot& formula) {
@@ -53,7 +53,7 @@ void NNFTransformer::visit(const LTLfPropositionalNot& formula) {
 void NNFTransformer::visit(const LTLfAnd& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_and(container);
       });
 }
@@ -61,7 +61,7 @@ void NNFTransformer::visit(const LTLfAnd& formula) {
 void NNFTransformer::visit(const LTLfOr& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_or(container);
       });
 }
@@ -92,7 +92,7 @@ void NNFTransformer::visit(const LTLfWeakNext& formula) {
 void NNFTransformer::visit(const LTLfUntil& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_until(container);
       });
 }
@@ -100,7 +100,7 @@ void NNFTransformer::visit(const LTLfUntil& formula) {
 void NNFTransformer::visit(const LTLfRelease& formula) {
   result = forward_call_to_arguments(
       formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
-      [formula](const vec_ptr& container) {
+      [&formula](const vec_ptr& container) {
         return formula.ctx().make_release(container);
       });
 }
@@ -113,9 +113,35 @@ void NNFTransformer::visit(const LTLfAlways& formula) {
   result = formula.ctx().make_always(apply(*formula.arg));
 }
 
-ltlf_ptr NNFTransformer::apply(const LTLfFormula& f) {
-  f.accept(*this);
-  return result;
+void NNFTransformer::for_each_dependency_(const LTLfFormula& formula,
+                                          const DependencyFunction& function) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfPropNot:
+    break;
+  case TypeID::t_LTLfNot:
+    // nnf(~f) is the negation of f
+    function(negation_transformer_, *static_cast<const LTLfNot&>(formula).arg);
+    break;
+  case TypeID::t_LTLfImplies: {
+    // nnf(a -> b) = nnf(~a | b)
+    const auto& args = static_cast<const LTLfImplies&>(formula).args;
+    for (auto it = args.begin(); it != args.end() - 1; ++it) {
+      function(negation_transformer_, **it);
+    }
+    function(*this, *args.back());
+    break;
+  }
+  case TypeID::t_LTLfEquivalent:
+  case TypeID::t_LTLfXor:
+    // the simplified formula has the arguments in both polarities
+    for_each_argument(formula, [this, &function](const LTLfFormula& argument) {
+      function(*this, argument);
+      function(negation_transformer_, argument);
+    });
+    break;
+  default:
+    MemoizingVisitor::for_each_dependency_(formula, function);
+  }
 }
 
 ltlf_ptr to_nnf(const LTLfFormula& f) {
@@ -16,21 +16,21 @@
  */
 
 #include <cynthia/logic/print.hpp>
-#include <sstream>
 
 namespace cynthia {
 namespace logic {
 
-void PrintVisitor::visit(const LTLfTrue& formula) { result = "tt"; }
-void PrintVisitor::visit(const LTLfFalse& formula) { result = "ff"; }
-void PrintVisitor::visit(const LTLfPropTrue& formula) { result = "true"; }
-void PrintVisitor::visit(const LTLfPropFalse& formula) { result = "false"; }
-void PrintVisitor::visit(const LTLfAtom& formula) { result = formula.name; }
+void PrintVisitor::visit(const LTLfTrue& formula) { result += "tt"; }
+void PrintVisitor::visit(const LTLfFalse& formula) { result += "ff"; }
+void PrintVisitor::visit(const LTLfPropTrue& formula) { result += "true"; }
+void PrintVisitor::visit(const LTLfPropFalse& formula) { result += "false"; }
+void PrintVisitor::visit(const LTLfAtom& formula) { result += formula.name; }
 void PrintVisitor::visit(const LTLfNot& formula) {
   unary_op_to_string(formula, "~");
 }
 void PrintVisitor::visit(const LTLfPropositionalNot& formula) {
-  result = "!" + formula.get_atom()->name;
+  result += "!";
+  result += formula.get_atom()->name;
 }
 void PrintVisitor::visit(const LTLfAnd& formula) {
   binary_op_to_string(formula, "&");
@@ -67,27 +67,43 @@ void PrintVisitor::visit(const LTLfAlways& formula) {
 }
 
 std::string PrintVisitor::apply(const LTLfFormula& f) {
-  f.accept(*this);
+  // the visit methods append leaves to the result, and push the pieces of
+  // compound formulas on the stack in reverse order; the loop then emits
+  // them left to right, so nothing recurses on the depth of the formula.
+  result.clear();
+  stack_.push_back(Token{&f, nullptr});
+  while (!stack_.empty()) {
+    auto token = stack_.back();
+    stack_.pop_back();
+    if (token.formula != nullptr) {
+      token.formula->accept(*this);
+    } else {
+      result += token.text;
+    }
+  }
   return result;
 }
 
 void PrintVisitor::binary_op_to_string(const LTLfBinaryOp& formula,
-                                       const std::string& op_symbol) {
-  std::stringstream ss;
-  std::string temp;
-  for (auto it = formula.args.begin(); it != formula.args.end() - 1; ++it) {
-    ss << "(" << apply(**it) << ") " << op_symbol << " ";
+                                       const char* op_symbol) {
+  for (auto it = formula.args.rbegin(); it != formula.args.rend(); ++it) {
+    stack_.push_back(Token{nullptr, ")"});
+    stack_.push_back(Token{it->get(), nullptr});
+    stack_.push_back(Token{nullptr, "("});
+    if (it + 1 != formula.args.rend()) {
+      stack_.push_back(Token{nullptr, " "});
+      stack_.push_back(Token{nullptr, op_symbol});
+      stack_.push_back(Token{nullptr, " "});
+    }
   }
-  ss << "(" << apply(**(formula.args.end() - 1)) << ")";
-  result = ss.str();
 }
 
 void PrintVisitor::unary_op_to_string(const LTLfUnaryOp& formula,
-                                      const std::string& op_symbol) {
-  std::stringstream ss;
-  std::string temp;
-  ss << op_symbol << "(" << apply(*formula.arg) << ")";
-  result = ss.str();
+                                      const char* op_symbol) {
+  stack_.push_back(Token{nullptr, ")"});
+  stack_.push_back(Token{formula.arg.get(), nullptr});
+  stack_.push_back(Token{nullptr, "("});
+  stack_.push_back(Token{nullptr, op_symbol});
 }
 
 std::string to_string(const LTLfFormula& f) {
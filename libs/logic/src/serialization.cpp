@@ -0,0 +1,370 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/memoizing_visitor.hpp>
+#include <cynthia/logic/serialization.hpp>
+#include <cynthia/mapped_file.hpp>
+
+namespace cynthia {
+namespace logic {
+
+namespace {
+
+const char magic[] = "CYNLTLF";
+const size_t magic_size = sizeof(magic) - 1;
+const char version = 1;
+
+// the node kinds of the format, independent of the TypeID values
+enum class NodeKind : uint8_t {
+  True = 0,
+  False = 1,
+  PropTrue = 2,
+  PropFalse = 3,
+  Atom = 4,
+  PropNot = 5,
+  Not = 6,
+  And = 7,
+  Or = 8,
+  Implies = 9,
+  Equivalent = 10,
+  Xor = 11,
+  Next = 12,
+  WeakNext = 13,
+  Until = 14,
+  Release = 15,
+  Eventually = 16,
+  Always = 17
+};
+
+NodeKind kind_of(const LTLfFormula& formula) {
+  switch (formula.get_type_code()) {
+  case TypeID::t_LTLfTrue:
+    return NodeKind::True;
+  case TypeID::t_LTLfFalse:
+    return NodeKind::False;
+  case TypeID::t_LTLfPropTrue:
+    return NodeKind::PropTrue;
+  case TypeID::t_LTLfPropFalse:
+    return NodeKind::PropFalse;
+  case TypeID::t_LTLfAtom:
+    return NodeKind::Atom;
+  case TypeID::t_LTLfPropNot:
+    return NodeKind::PropNot;
+  case TypeID::t_LTLfNot:
+    return NodeKind::Not;
+  case TypeID::t_LTLfAnd:
+    return NodeKind::And;
+  case TypeID::t_LTLfOr:
+    return NodeKind::Or;
+  case TypeID::t_LTLfImplies:
+    return NodeKind::Implies;
+  case TypeID::t_LTLfEquivalent:
+    return NodeKind::Equivalent;
+  case TypeID::t_LTLfXor:
+    return NodeKind::Xor;
+  case TypeID::t_LTLfNext:
+    return NodeKind::Next;
+  case TypeID::t_LTLfWeakNext:
+    return NodeKind::WeakNext;
+  case TypeID::t_LTLfUntil:
+    return NodeKind::Until;
+  case TypeID::t_LTLfRelease:
+    return NodeKind::Release;
+  case TypeID::t_LTLfEventually:
+    return NodeKind::Eventually;
+  case TypeID::t_LTLfAlways:
+    return NodeKind::Always;
+  default:
+    throw std::invalid_argument("cannot serialize the formula");
+  }
+}
+
+void write_varint(std::string& buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+class BinaryReader {
+private:
+  const unsigned char* position_;
+  const unsigned char* const end_;
+
+public:
+  BinaryReader(const char* data, size_t size)
+      : position_{reinterpret_cast<const unsigned char*>(data)},
+        end_{position_ + size} {}
+
+  static std::runtime_error error(const std::string& message) {
+    return std::runtime_error("invalid binary formula: " + message);
+  }
+
+  uint8_t read_byte() {
+    if (position_ == end_) {
+      throw error("unexpected end of data");
+    }
+    return *position_++;
+  }
+
+  uint64_t read_varint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      auto byte = read_byte();
+      value |= uint64_t(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw error("varint too long");
+  }
+
+  // read an index smaller than bound
+  size_t read_index(size_t bound) {
+    auto index = read_varint();
+    if (index >= bound) {
+      throw error("index out of range");
+    }
+    return static_cast<size_t>(index);
+  }
+
+  std::string read_string() {
+    auto size = read_varint();
+    if (size > static_cast<uint64_t>(end_ - position_)) {
+      throw error("unexpected end of data");
+    }
+    std::string result(reinterpret_cast<const char*>(position_), size);
+    position_ += size;
+    return result;
+  }
+
+  bool at_end() const { return position_ == end_; }
+};
+
+} // namespace
+
+void write_binary(const LTLfFormula& formula, std::ostream& out) {
+  std::unordered_map<const LTLfFormula*, size_t> index;
+  std::unordered_map<size_t, size_t> symbol_index;
+  std::vector<std::string> symbols;
+  std::string nodes;
+  auto write_node = [&index, &symbol_index, &symbols,
+                     &nodes](const LTLfFormula* node) {
+    auto kind = kind_of(*node);
+    nodes.push_back(static_cast<char>(kind));
+    switch (node->get_type_code()) {
+    case TypeID::t_LTLfAtom: {
+      const auto& atom = static_cast<const LTLfAtom&>(*node);
+      auto it = symbol_index.emplace(atom.symbol_id, symbols.size()).first;
+      if (it->second == symbols.size()) {
+        symbols.push_back(atom.name);
+      }
+      write_varint(nodes, it->second);
+      break;
+    }
+    case TypeID::t_LTLfPropNot:
+    case TypeID::t_LTLfNot:
+    case TypeID::t_LTLfNext:
+    case TypeID::t_LTLfWeakNext:
+    case TypeID::t_LTLfEventually:
+    case TypeID::t_LTLfAlways:
+      write_varint(nodes,
+                   index.at(static_cast<const LTLfUnaryOp&>(*node).arg.get()));
+      break;
+    case TypeID::t_LTLfAnd:
+    case TypeID::t_LTLfOr:
+    case TypeID::t_LTLfImplies:
+    case TypeID::t_LTLfEquivalent:
+    case TypeID::t_LTLfXor:
+    case TypeID::t_LTLfUntil:
+    case TypeID::t_LTLfRelease: {
+      const auto& args = static_cast<const LTLfBinaryOp&>(*node).args;
+      write_varint(nodes, args.size());
+      for (const auto& arg : args) {
+        write_varint(nodes, index.at(arg.get()));
+      }
+      break;
+    }
+    default:
+      break;
+    }
+    auto node_index = index.size();
+    index[node] = node_index;
+  };
+  compute_bottom_up(
+      &formula,
+      [&index](const LTLfFormula* node) { return index.count(node) > 0; },
+      [](const LTLfFormula* node, auto push) {
+        for_each_argument(*node,
+                          [&push](const LTLfFormula& arg) { push(&arg); });
+      },
+      write_node);
+
+  std::string header(magic, magic_size);
+  header.push_back(version);
+  write_varint(header, symbols.size());
+  for (const auto& symbol : symbols) {
+    write_varint(header, symbol.size());
+    header += symbol;
+  }
+  write_varint(header, index.size());
+  std::string footer;
+  write_varint(footer, index.at(&formula));
+
+  out.write(header.data(), header.size());
+  out.write(nodes.data(), nodes.size());
+  out.write(footer.data(), footer.size());
+}
+
+void save_binary(const LTLfFormula& formula, const std::string& filename) {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("cannot open " + filename + " for writing");
+  }
+  write_binary(formula, out);
+  if (!out) {
+    throw std::runtime_error("cannot write " + filename);
+  }
+}
+
+ltlf_ptr read_binary(Context& context, const char* data, size_t size) {
+  if (size < magic_size + 1 or std::memcmp(data, magic, magic_size) != 0) {
+    throw BinaryReader::error("bad magic");
+  }
+  if (data[magic_size] != version) {
+    throw BinaryReader::error("unsupported version");
+  }
+  auto reader = BinaryReader(data + magic_size + 1, size - magic_size - 1);
+
+  auto nb_symbols = reader.read_varint();
+  std::vector<ltlf_ptr> atoms;
+  for (uint64_t i = 0; i < nb_symbols; ++i) {
+    atoms.push_back(context.make_atom(reader.read_string()));
+  }
+
+  auto nb_nodes = reader.read_varint();
+  std::vector<ltlf_ptr> nodes;
+  auto read_arg = [&reader, &nodes]() {
+    return nodes[reader.read_index(nodes.size())];
+  };
+  auto read_args = [&reader, &read_arg]() {
+    auto count = reader.read_varint();
+    if (count == 0) {
+      throw BinaryReader::error("operator without arguments");
+    }
+    vec_ptr args;
+    for (uint64_t i = 0; i < count; ++i) {
+      args.push_back(read_arg());
+    }
+    return args;
+  };
+  for (uint64_t i = 0; i < nb_nodes; ++i) {
+    ltlf_ptr node;
+    switch (static_cast<NodeKind>(reader.read_byte())) {
+    case NodeKind::True:
+      node = context.make_tt();
+      break;
+    case NodeKind::False:
+      node = context.make_ff();
+      break;
+    case NodeKind::PropTrue:
+      node = context.make_prop_true();
+      break;
+    case NodeKind::PropFalse:
+      node = context.make_prop_false();
+      break;
+    case NodeKind::Atom:
+      node = atoms[reader.read_index(atoms.size())];
+      break;
+    case NodeKind::PropNot: {
+      auto arg = read_arg();
+      if (arg->get_type_code() != TypeID::t_LTLfAtom) {
+        throw BinaryReader::error("propositional not of a non-atom");
+      }
+      node = context.make_prop_not(arg);
+      break;
+    }
+    case NodeKind::Not:
+      node = context.make_not(read_arg());
+      break;
+    case NodeKind::And:
+      node = context.make_and(read_args());
+      break;
+    case NodeKind::Or:
+      node = context.make_or(read_args());
+      break;
+    case NodeKind::Implies:
+      node = context.make_implies(read_args());
+      break;
+    case NodeKind::Equivalent:
+      node = context.make_equivalent(read_args());
+      break;
+    case NodeKind::Xor:
+      node = context.make_xor(read_args());
+      break;
+    case NodeKind::Next:
+      node = context.make_next(read_arg());
+      break;
+    case NodeKind::WeakNext:
+      node = context.make_weak_next(read_arg());
+      break;
+    case NodeKind::Until:
+      node = context.make_until(read_args());
+      break;
+    case NodeKind::Release:
+      node = context.make_release(read_args());
+      break;
+    case NodeKind::Eventually:
+      node = context.make_eventually(read_arg());
+      break;
+    case NodeKind::Always:
+      node = context.make_always(read_arg());
+      break;
+    default:
+      throw BinaryReader::error("unknown node kind");
+    }
+    nodes.push_back(node);
+  }
+
+  auto root = nodes[reader.read_index(nodes.size())];
+  if (!reader.at_end()) {
+    throw BinaryReader::error("trailing data");
+  }
+  return root;
+}
+
+ltlf_ptr load_binary(Context& context, const std::string& filename) {
+  auto file = utils::MappedFile(filename);
+  return read_binary(context, file.data(), file.size());
+}
+
+bool is_binary_file(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  char buffer[magic_size];
+  return in.read(buffer, magic_size) and
+         std::memcmp(buffer, magic, magic_size) == 0;
+}
+
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,379 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <unordered_set>
+
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/simplifier.hpp>
+
+namespace cynthia {
+namespace logic {
+
+namespace {
+
+bool is_type(const ltlf_ptr& formula, TypeID type) {
+  return formula->get_type_code() == type;
+}
+
+bool is_false(const ltlf_ptr& formula) {
+  return is_type(formula, TypeID::t_LTLfFalse) or
+         is_type(formula, TypeID::t_LTLfPropFalse);
+}
+
+const vec_ptr& args_of(const ltlf_ptr& formula) {
+  return static_cast<const LTLfBinaryOp&>(*formula).args;
+}
+
+const ltlf_ptr& arg_of(const ltlf_ptr& formula) {
+  return static_cast<const LTLfUnaryOp&>(*formula).arg;
+}
+
+} // namespace
+
+void Simplifier::visit(const LTLfTrue& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfFalse& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfPropTrue& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfPropFalse& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfAtom& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfNot& formula) {
+  result = formula.ctx().make_not(apply(*formula.arg));
+}
+
+void Simplifier::visit(const LTLfPropositionalNot& formula) {
+  result = formula.shared_from_this();
+}
+
+void Simplifier::visit(const LTLfAnd& formula) {
+  result = simplify_connective_(formula, true);
+}
+
+void Simplifier::visit(const LTLfOr& formula) {
+  result = simplify_connective_(formula, false);
+}
+
+void Simplifier::visit(const LTLfImplies& formula) {
+  result = forward_call_to_arguments(
+      formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const vec_ptr& container) {
+        return formula.ctx().make_implies(container);
+      });
+}
+
+void Simplifier::visit(const LTLfEquivalent& formula) {
+  result = forward_call_to_arguments(
+      formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const vec_ptr& container) {
+        return formula.ctx().make_equivalent(container);
+      });
+}
+
+void Simplifier::visit(const LTLfXor& formula) {
+  result = forward_call_to_arguments(
+      formula, [this](const ltlf_ptr& formula) { return apply(*formula); },
+      [&formula](const vec_ptr& container) {
+        return formula.ctx().make_xor(container);
+      });
+}
+
+void Simplifier::visit(const LTLfNext& formula) {
+  result = make_next_(formula.ctx(), apply(*formula.arg), true);
+}
+
+void Simplifier::visit(const LTLfWeakNext& formula) {
+  result = make_next_(formula.ctx(), apply(*formula.arg), false);
+}
+
+void Simplifier::visit(const LTLfUntil& formula) {
+  auto& c = formula.ctx();
+  vec_ptr args(formula.args.size());
+  std::transform(formula.args.begin(), formula.args.end(), args.begin(),
+                 [this](const ltlf_ptr& arg) { return apply(*arg); });
+  if (options_.constant_propagation) {
+    // f U ff = ff, and tt U f = F f
+    if (is_false(args.back())) {
+      result = c.make_ff();
+      return;
+    }
+    if (args.size() == 2 and is_type(args[0], TypeID::t_LTLfTrue)) {
+      result = apply(*c.make_eventually(args[1]));
+      return;
+    }
+  }
+  // f U (f U g) = f U g
+  if (options_.temporal_absorption and args.size() == 2 and
+      is_type(args[1], TypeID::t_LTLfUntil) and
+      args_of(args[1]).front() == args[0]) {
+    result = args[1];
+    return;
+  }
+  result = c.make_until(args);
+}
+
+void Simplifier::visit(const LTLfRelease& formula) {
+  auto& c = formula.ctx();
+  vec_ptr args(formula.args.size());
+  std::transform(formula.args.begin(), formula.args.end(), args.begin(),
+                 [this](const ltlf_ptr& arg) { return apply(*arg); });
+  if (options_.constant_propagation) {
+    // f R tt = tt, and ff R f = G f
+    if (is_type(args.back(), TypeID::t_LTLfTrue)) {
+      result = c.make_tt();
+      return;
+    }
+    if (args.size() == 2 and is_type(args[0], TypeID::t_LTLfFalse)) {
+      result = apply(*c.make_always(args[1]));
+      return;
+    }
+  }
+  // f R (f R g) = f R g
+  if (options_.temporal_absorption and args.size() == 2 and
+      is_type(args[1], TypeID::t_LTLfRelease) and
+      args_of(args[1]).front() == args[0]) {
+    result = args[1];
+    return;
+  }
+  result = c.make_release(args);
+}
+
+void Simplifier::visit(const LTLfEventually& formula) {
+  auto arg = apply(*formula.arg);
+  if (options_.constant_propagation and is_false(arg)) {
+    result = formula.ctx().make_ff();
+  } else if (options_.temporal_absorption and
+             is_type(arg, TypeID::t_LTLfEventually)) {
+    result = arg;
+  } else {
+    result = formula.ctx().make_eventually(arg);
+  }
+}
+
+void Simplifier::visit(const LTLfAlways& formula) {
+  auto arg = apply(*formula.arg);
+  if (options_.constant_propagation and is_type(arg, TypeID::t_LTLfTrue)) {
+    result = formula.ctx().make_tt();
+  } else if (options_.temporal_absorption and
+             is_type(arg, TypeID::t_LTLfAlways)) {
+    result = arg;
+  } else {
+    result = formula.ctx().make_always(arg);
+  }
+}
+
+ltlf_ptr Simplifier::make_next_(Context& context, const ltlf_ptr& arg,
+                                bool strong) {
+  if (options_.constant_propagation) {
+    // X[!]ff = ff, since it requires a next instant where ff holds; WX tt
+    // holds whether or not there is a next instant. X[!]tt (not last) and
+    // WX ff (last) are kept.
+    if (strong and is_false(arg)) {
+      return context.make_ff();
+    }
+    if (not strong and is_type(arg, TypeID::t_LTLfTrue)) {
+      return context.make_tt();
+    }
+  }
+  return strong ? context.make_next(arg) : context.make_weak_next(arg);
+}
+
+ltlf_ptr Simplifier::simplify_connective_(const LTLfBinaryOp& formula,
+                                          bool is_and) {
+  auto& c = formula.ctx();
+  auto type = formula.get_type_code();
+  // the simplified arguments, flattened and without duplicates
+  vec_ptr args;
+  std::unordered_set<const LTLfFormula*> seen;
+  auto add = [&args, &seen](const ltlf_ptr& arg) {
+    if (seen.insert(arg.get()).second) {
+      args.push_back(arg);
+    }
+  };
+  for (const auto& arg : formula.args) {
+    auto simplified = apply(*arg);
+    if (simplified->get_type_code() == type) {
+      for (const auto& nested_arg : args_of(simplified)) {
+        add(nested_arg);
+      }
+    } else {
+      add(simplified);
+    }
+  }
+
+  if (options_.next_distribution) {
+    distribute_nexts_(c, args, is_and);
+  }
+  if (options_.constant_propagation and
+      propagate_constants_(c, args, is_and)) {
+    return c.make_bool(not is_and);
+  }
+  if (options_.subsumption) {
+    remove_subsumed_(args, is_and);
+  }
+  return is_and ? c.make_and(args) : c.make_or(args);
+}
+
+void Simplifier::distribute_nexts_(Context& context, vec_ptr& args,
+                                   bool is_and) {
+  // X f & WX g = X (f & g) and X f | WX g = WX (f | g): the conjunction is
+  // strong if any argument is, the disjunction if all the arguments are
+  vec_ptr others;
+  vec_ptr next_args;
+  bool any_strong = false;
+  bool any_weak = false;
+  for (const auto& arg : args) {
+    if (is_type(arg, TypeID::t_LTLfNext)) {
+      any_strong = true;
+      next_args.push_back(arg_of(arg));
+    } else if (is_type(arg, TypeID::t_LTLfWeakNext)) {
+      any_weak = true;
+      next_args.push_back(arg_of(arg));
+    } else {
+      others.push_back(arg);
+    }
+  }
+  if (next_args.size() < 2) {
+    return;
+  }
+  auto inner =
+      is_and ? context.make_and(next_args) : context.make_or(next_args);
+  bool strong = is_and ? any_strong : not any_weak;
+  others.push_back(make_next_(context, apply(*inner), strong));
+  args = std::move(others);
+}
+
+bool Simplifier::propagate_constants_(Context& context, vec_ptr& args,
+                                      bool is_and) {
+  // returns whether the connective reduces to its absorbing element
+  vec_ptr kept;
+  bool has_prop_true = false;
+  std::unordered_set<const LTLfFormula*> members;
+  for (const auto& arg : args) {
+    switch (arg->get_type_code()) {
+    case TypeID::t_LTLfTrue:
+      if (not is_and) {
+        return true;
+      }
+      break;
+    case TypeID::t_LTLfFalse:
+    case TypeID::t_LTLfPropFalse:
+      if (is_and) {
+        return true;
+      }
+      break;
+    case TypeID::t_LTLfPropTrue:
+      has_prop_true = true;
+      break;
+    default:
+      kept.push_back(arg);
+      members.insert(arg.get());
+    }
+  }
+
+  // a & !a = ff, while a | !a = true: it does not hold on the empty trace
+  for (const auto& arg : kept) {
+    if (is_type(arg, TypeID::t_LTLfPropNot) and
+        members.count(arg_of(arg).get())) {
+      if (is_and) {
+        return true;
+      }
+      has_prop_true = true;
+      break;
+    }
+  }
+
+  // true holds on every non-empty trace, so it is implied by any formula
+  // that does not accept the empty trace
+  auto rejects_empty_trace = [](const ltlf_ptr& arg) {
+    return not arg->accepts_empty_trace();
+  };
+  if (has_prop_true) {
+    if (not is_and) {
+      kept.erase(
+          std::remove_if(kept.begin(), kept.end(), rejects_empty_trace),
+          kept.end());
+      kept.push_back(context.make_prop_true());
+    } else if (std::none_of(kept.begin(), kept.end(), rejects_empty_trace)) {
+      kept.push_back(context.make_prop_true());
+    }
+  }
+  args = std::move(kept);
+  return false;
+}
+
+void Simplifier::remove_subsumed_(vec_ptr& args, bool is_and) {
+  // in a conjunction, a disjunction is implied by any other argument that
+  // is one of its disjuncts, or a disjunction of a subset of them; dually
+  // for disjunctions. Arguments are distinct, so no two of them subsume
+  // each other.
+  auto dual = is_and ? TypeID::t_LTLfOr : TypeID::t_LTLfAnd;
+  auto subsumes = [dual](const ltlf_ptr& formula,
+                         const std::unordered_set<const LTLfFormula*>& set) {
+    if (not is_type(formula, dual)) {
+      return set.count(formula.get()) > 0;
+    }
+    const auto& elements = args_of(formula);
+    return elements.size() < set.size() and
+           std::all_of(elements.begin(), elements.end(),
+                       [&set](const ltlf_ptr& element) {
+                         return set.count(element.get()) > 0;
+                       });
+  };
+
+  vec_ptr kept;
+  for (const auto& arg : args) {
+    bool is_subsumed = false;
+    if (is_type(arg, dual)) {
+      const auto& elements = args_of(arg);
+      std::unordered_set<const LTLfFormula*> set;
+      for (const auto& element : elements) {
+        set.insert(element.get());
+      }
+      is_subsumed =
+          std::any_of(args.begin(), args.end(),
+                      [&arg, &set, &subsumes](const ltlf_ptr& other) {
+                        return other != arg and subsumes(other, set);
+                      });
+    }
+    if (not is_subsumed) {
+      kept.push_back(arg);
+    }
+  }
+  args = std::move(kept);
+}
+
+ltlf_ptr simplify_formula(const LTLfFormula& f,
+                          const SimplifierOptions& options) {
+  auto visitor = Simplifier{options};
+  return visitor.apply(f);
+}
+
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,352 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <cynthia/logic/memoizing_visitor.hpp>
+#include <cynthia/logic/trace_evaluator.hpp>
+
+namespace cynthia {
+namespace logic {
+
+TraceEvaluator::TraceEvaluator(const LTLfFormula& formula) {
+  std::unordered_map<const LTLfFormula*, uint32_t> index;
+  auto compile = [this, &index](const LTLfFormula* node) {
+    std::vector<uint32_t> arguments;
+    for_each_argument(*node, [&arguments, &index](const LTLfFormula& arg) {
+      arguments.push_back(index.at(&arg));
+    });
+    uint32_t result;
+    switch (node->get_type_code()) {
+    case TypeID::t_LTLfTrue:
+      result = add_instruction_(Op::True, arguments);
+      break;
+    case TypeID::t_LTLfFalse:
+      result = add_instruction_(Op::False, arguments);
+      break;
+    case TypeID::t_LTLfPropTrue:
+      result = add_instruction_(Op::PropTrue, arguments);
+      break;
+    case TypeID::t_LTLfPropFalse:
+      result = add_instruction_(Op::PropFalse, arguments);
+      break;
+    case TypeID::t_LTLfAtom: {
+      auto symbol_id = static_cast<const LTLfAtom*>(node)->symbol_id;
+      if (symbol_id >= symbol_to_atom_.size()) {
+        symbol_to_atom_.resize(symbol_id + 1, no_atom);
+      }
+      symbol_to_atom_[symbol_id] = static_cast<uint32_t>(atom_symbols_.size());
+      atom_symbols_.push_back(symbol_id);
+      result = add_instruction_(Op::Atom, arguments);
+      program_.back().first = symbol_to_atom_[symbol_id];
+      break;
+    }
+    case TypeID::t_LTLfPropNot:
+      result = add_instruction_(Op::PropNot, arguments);
+      break;
+    case TypeID::t_LTLfNot:
+      result = add_instruction_(Op::Not, arguments);
+      break;
+    case TypeID::t_LTLfAnd:
+      result = add_instruction_(Op::And, arguments);
+      break;
+    case TypeID::t_LTLfOr:
+      result = add_instruction_(Op::Or, arguments);
+      break;
+    case TypeID::t_LTLfImplies:
+      result = add_instruction_(Op::Implies, arguments);
+      break;
+    case TypeID::t_LTLfEquivalent:
+      result = add_instruction_(Op::Equivalent, arguments);
+      break;
+    case TypeID::t_LTLfXor:
+      result = add_instruction_(Op::Xor, arguments);
+      break;
+    case TypeID::t_LTLfNext:
+      result = add_instruction_(Op::Next, arguments);
+      break;
+    case TypeID::t_LTLfWeakNext:
+      result = add_instruction_(Op::WeakNext, arguments);
+      break;
+    case TypeID::t_LTLfEventually:
+      result = add_instruction_(Op::Eventually, arguments);
+      break;
+    case TypeID::t_LTLfAlways:
+      result = add_instruction_(Op::Always, arguments);
+      break;
+    case TypeID::t_LTLfUntil:
+    case TypeID::t_LTLfRelease: {
+      // a U b U c = a U (b U c): one binary instruction per operator
+      auto op = node->get_type_code() == TypeID::t_LTLfUntil ? Op::Until
+                                                             : Op::Release;
+      result = arguments.back();
+      for (auto it = arguments.rbegin() + 1; it != arguments.rend(); ++it) {
+        result = add_instruction_(op, {*it, result});
+      }
+      break;
+    }
+    default:
+      throw std::invalid_argument("cannot evaluate formula on traces");
+    }
+    index[node] = result;
+  };
+  compute_bottom_up(
+      &formula,
+      [&index](const LTLfFormula* node) { return index.count(node) > 0; },
+      [](const LTLfFormula* node, auto push) {
+        for_each_argument(*node,
+                          [&push](const LTLfFormula& arg) { push(&arg); });
+      },
+      compile);
+  root_ = index.at(&formula);
+  compute_empty_values_();
+}
+
+uint32_t TraceEvaluator::add_instruction_(
+    Op op, const std::vector<uint32_t>& arguments) {
+  auto first = static_cast<uint32_t>(operands_.size());
+  operands_.insert(operands_.end(), arguments.begin(), arguments.end());
+  program_.push_back(
+      Instruction{op, first, static_cast<uint32_t>(arguments.size())});
+  return static_cast<uint32_t>(program_.size() - 1);
+}
+
+void TraceEvaluator::compute_empty_values_() {
+  // on the empty trace, no atom holds, there is no next instant, and the
+  // temporal operators take their base case
+  empty_values_.resize(program_.size());
+  for (size_t k = 0; k < program_.size(); ++k) {
+    const auto& instruction = program_[k];
+    auto begin = operands_.begin() + instruction.first;
+    auto end = begin + instruction.count;
+    auto value_of = [this](uint32_t operand) {
+      return static_cast<bool>(empty_values_[operand]);
+    };
+    bool value = false;
+    switch (instruction.op) {
+    case Op::True:
+    case Op::WeakNext:
+    case Op::Release:
+    case Op::Always:
+      value = true;
+      break;
+    case Op::Not:
+      value = !value_of(*begin);
+      break;
+    case Op::And:
+      value = std::all_of(begin, end, value_of);
+      break;
+    case Op::Or:
+      value = std::any_of(begin, end, value_of);
+      break;
+    case Op::Implies:
+      value = !std::all_of(begin, end - 1, value_of) or value_of(*(end - 1));
+      break;
+    case Op::Equivalent:
+    case Op::Xor: {
+      bool all_equal = std::all_of(begin, end, [&](uint32_t operand) {
+        return value_of(operand) == value_of(*begin);
+      });
+      value = (instruction.op == Op::Equivalent) == all_equal;
+      break;
+    }
+    default:
+      value = false;
+    }
+    empty_values_[k] = value;
+  }
+}
+
+bool TraceEvaluator::evaluate(const trace_t& trace) const {
+  std::vector<bool> results(1);
+  evaluate_batch_({&trace}, results, 0);
+  return results[0];
+}
+
+std::vector<bool>
+TraceEvaluator::evaluate(const std::vector<trace_t>& traces) const {
+  std::vector<bool> results(traces.size());
+  std::vector<const trace_t*> batch;
+  batch.reserve(batch_size);
+  for (size_t begin = 0; begin < traces.size(); begin += batch_size) {
+    auto end = std::min(begin + batch_size, traces.size());
+    batch.clear();
+    for (size_t j = begin; j < end; ++j) {
+      batch.push_back(&traces[j]);
+    }
+    evaluate_batch_(batch, results, begin);
+  }
+  return results;
+}
+
+void TraceEvaluator::evaluate_batch_(const std::vector<const trace_t*>& traces,
+                                     std::vector<bool>& results,
+                                     size_t offset) const {
+  const Lanes zeros{};
+  Lanes ones;
+  ones.fill(UINT64_MAX);
+
+  size_t max_length = 0;
+  for (const auto* trace : traces) {
+    max_length = std::max(max_length, trace->size());
+  }
+
+  // the atoms that hold in each trace at each instant, and the traces
+  // that end at each instant
+  auto nb_atoms = atom_symbols_.size();
+  std::vector<Lanes> atoms(max_length * nb_atoms, zeros);
+  std::vector<Lanes> ending(max_length + 1, zeros);
+  for (size_t j = 0; j < traces.size(); ++j) {
+    auto word = j / 64;
+    auto bit = uint64_t(1) << (j % 64);
+    const auto& trace = *traces[j];
+    ending[trace.size()][word] |= bit;
+    for (size_t i = 0; i < trace.size(); ++i) {
+      for (auto symbol_id : trace[i]) {
+        if (symbol_id < symbol_to_atom_.size() and
+            symbol_to_atom_[symbol_id] != no_atom) {
+          atoms[i * nb_atoms + symbol_to_atom_[symbol_id]][word] |= bit;
+        }
+      }
+    }
+  }
+
+  // the values at the current and at the next instant; past the end of a
+  // trace, every instruction keeps its value on the empty trace
+  std::vector<Lanes> current(program_.size());
+  std::vector<Lanes> next(program_.size());
+  for (size_t k = 0; k < program_.size(); ++k) {
+    next[k] = empty_values_[k] ? ones : zeros;
+  }
+  // the traces longer than i + 1, that is, with a next instant
+  Lanes has_next = zeros;
+  for (size_t i = max_length; i-- > 0;) {
+    Lanes active;
+    for (size_t w = 0; w < nb_words; ++w) {
+      active[w] = has_next[w] | ending[i + 1][w];
+    }
+    for (size_t k = 0; k < program_.size(); ++k) {
+      const auto& instruction = program_[k];
+      const auto* args = operands_.data() + instruction.first;
+      Lanes value;
+      switch (instruction.op) {
+      case Op::True:
+      case Op::PropTrue:
+        value = ones;
+        break;
+      case Op::False:
+      case Op::PropFalse:
+        value = zeros;
+        break;
+      case Op::Atom:
+        value = atoms[i * nb_atoms + instruction.first];
+        break;
+      case Op::PropNot:
+      case Op::Not:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = ~current[args[0]][w];
+        }
+        break;
+      case Op::And:
+        value = ones;
+        for (uint32_t a = 0; a < instruction.count; ++a) {
+          for (size_t w = 0; w < nb_words; ++w) {
+            value[w] &= current[args[a]][w];
+          }
+        }
+        break;
+      case Op::Or:
+        value = zeros;
+        for (uint32_t a = 0; a < instruction.count; ++a) {
+          for (size_t w = 0; w < nb_words; ++w) {
+            value[w] |= current[args[a]][w];
+          }
+        }
+        break;
+      case Op::Implies:
+        value = current[args[instruction.count - 1]];
+        for (uint32_t a = 0; a + 1 < instruction.count; ++a) {
+          for (size_t w = 0; w < nb_words; ++w) {
+            value[w] |= ~current[args[a]][w];
+          }
+        }
+        break;
+      case Op::Equivalent:
+      case Op::Xor: {
+        Lanes all_true = ones;
+        Lanes all_false = ones;
+        for (uint32_t a = 0; a < instruction.count; ++a) {
+          for (size_t w = 0; w < nb_words; ++w) {
+            all_true[w] &= current[args[a]][w];
+            all_false[w] &= ~current[args[a]][w];
+          }
+        }
+        auto mask = instruction.op == Op::Equivalent ? 0 : UINT64_MAX;
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = (all_true[w] | all_false[w]) ^ mask;
+        }
+        break;
+      }
+      case Op::Next:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = has_next[w] & next[args[0]][w];
+        }
+        break;
+      case Op::WeakNext:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = ~has_next[w] | next[args[0]][w];
+        }
+        break;
+      case Op::Until:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = current[args[1]][w] | (current[args[0]][w] & next[k][w]);
+        }
+        break;
+      case Op::Release:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = current[args[1]][w] & (current[args[0]][w] | next[k][w]);
+        }
+        break;
+      case Op::Eventually:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = current[args[0]][w] | next[k][w];
+        }
+        break;
+      case Op::Always:
+        for (size_t w = 0; w < nb_words; ++w) {
+          value[w] = current[args[0]][w] & next[k][w];
+        }
+        break;
+      }
+      auto empty_value = empty_values_[k] ? UINT64_MAX : 0;
+      for (size_t w = 0; w < nb_words; ++w) {
+        current[k][w] = (value[w] & active[w]) | (empty_value & ~active[w]);
+      }
+    }
+    std::swap(current, next);
+    has_next = active;
+  }
+
+  const auto& root = next[root_];
+  for (size_t j = 0; j < traces.size(); ++j) {
+    results[offset + j] = (root[j / 64] >> (j % 64)) & 1;
+  }
+}
+
+} // namespace logic
+} // namespace cynthia
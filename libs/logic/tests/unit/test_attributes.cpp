@@ -0,0 +1,130 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/atom_set.hpp>
+#include <cynthia/logic/ltlf.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+TEST_CASE("Atom sets", "[logic][attributes]") {
+  auto a = AtomSet::singleton(1);
+  auto b = AtomSet::singleton(70);
+  REQUIRE(a->contains(1));
+  REQUIRE(!a->contains(70));
+  REQUIRE(!a->contains(1000));
+
+  auto ab = AtomSet::union_of({a, b, nullptr});
+  REQUIRE(ab->size() == 2);
+  REQUIRE(a->is_subset_of(*ab));
+  REQUIRE(!ab->is_subset_of(*a));
+  REQUIRE(ab->intersects(*b));
+  REQUIRE(!a->intersects(*b));
+  std::vector<size_t> ids;
+  ab->for_each([&ids](size_t id) { ids.push_back(id); });
+  REQUIRE(ids == std::vector<size_t>{1, 70});
+
+  // a set containing the others is reused
+  REQUIRE(AtomSet::union_of({a, ab}) == ab);
+  REQUIRE(AtomSet::union_of({nullptr, nullptr}) == nullptr);
+  REQUIRE(*AtomSet::union_of({b, a}) == *ab);
+}
+
+TEST_CASE("Attributes of atomic formulas", "[logic][attributes]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+
+  REQUIRE(context.make_tt()->accepts_empty_trace());
+  REQUIRE(!context.make_ff()->accepts_empty_trace());
+  REQUIRE(!context.make_tt()->is_propositional());
+  REQUIRE(context.make_prop_true()->is_propositional());
+  REQUIRE(!context.make_prop_true()->accepts_empty_trace());
+  REQUIRE(a->is_propositional());
+  REQUIRE(!a->accepts_empty_trace());
+  REQUIRE(a->atoms().contains(context.symbols().get_id("a")));
+  REQUIRE(a->atoms().size() == 1);
+  REQUIRE(a->tree_size() == 1);
+  REQUIRE(a->temporal_depth() == 0);
+  REQUIRE(context.make_tt()->atoms().empty());
+}
+
+TEST_CASE("Attributes of compound formulas", "[logic][attributes]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+
+  auto a_and_not_b = context.make_and({a, context.make_prop_not(b)});
+  REQUIRE(a_and_not_b->is_propositional());
+  REQUIRE(a_and_not_b->tree_size() == 4);
+  REQUIRE(a_and_not_b->temporal_depth() == 0);
+  REQUIRE(a_and_not_b->atoms().size() == 2);
+
+  // X[!](a & !b) U G(c)
+  auto f = context.make_until(
+      {context.make_next(a_and_not_b), context.make_always(c)});
+  REQUIRE(!f->is_propositional());
+  REQUIRE(!f->accepts_empty_trace());
+  REQUIRE(f->tree_size() == 8);
+  REQUIRE(f->temporal_depth() == 2);
+  REQUIRE(f->atoms().size() == 3);
+  REQUIRE(f->atoms().contains(context.symbols().get_id("c")));
+
+  // unary operators share the atoms of their argument
+  auto g = context.make_weak_next(f);
+  REQUIRE(&g->atoms() == &f->atoms());
+  REQUIRE(g->accepts_empty_trace());
+  REQUIRE(g->temporal_depth() == 3);
+
+  auto not_f = context.make_not(f);
+  REQUIRE(not_f->accepts_empty_trace());
+  REQUIRE(!context.make_implies({not_f, f})->accepts_empty_trace());
+  REQUIRE(context.make_implies({f, not_f})->accepts_empty_trace());
+  REQUIRE(context.make_equivalent({f, a})->accepts_empty_trace());
+  REQUIRE(!context.make_xor({f, a})->accepts_empty_trace());
+  REQUIRE(context.make_xor({g, a})->accepts_empty_trace());
+}
+
+TEST_CASE("Tree size saturates", "[logic][attributes]") {
+  auto context = Context();
+  // f_{i+1} = f_i & X[!] f_i doubles the tree size at each step
+  ltlf_ptr f = context.make_atom("a");
+  for (size_t i = 0; i < 100; ++i) {
+    f = context.make_and({f, context.make_next(f)});
+  }
+  REQUIRE(f->tree_size() == std::numeric_limits<uint64_t>::max());
+  REQUIRE(f->temporal_depth() == 100);
+}
+
+TEST_CASE("Attributes are computed when interning", "[logic][attributes]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto f = context.make_until({a, b});
+  REQUIRE(f->atoms().size() == 2);
+
+  // a duplicate of an interned node is dropped before computing them
+  auto duplicate = std::make_shared<const LTLfUntil>(context, vec_ptr{a, b});
+  REQUIRE(*duplicate == *f);
+  REQUIRE(duplicate->atoms().size() == 0);
+  REQUIRE(context.make_until({a, b}) == f);
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,165 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/nnf.hpp>
+#include <cynthia/logic/print.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+// deep enough to overflow the native stack with one frame per level
+static const size_t depth = 1000000;
+
+TEST_CASE("NNF of a very deep formula", "[logic][deep]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  // X^n a, and the NNF of its negation, WX^n (!a | end)
+  ltlf_ptr f = a;
+  ltlf_ptr expected = context.make_or({context.make_prop_not(a),
+                                       context.make_end()});
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_next(f);
+    expected = context.make_weak_next(expected);
+  }
+  REQUIRE(to_nnf(*f) == f);
+  REQUIRE(to_nnf(*context.make_not(f)) == expected);
+}
+
+TEST_CASE("NNF of a very deep alternation of negations", "[logic][deep]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  // g_{i+1} = ~X(g_i): the negations alternate between the NNF and the
+  // negation transformers at every level
+  ltlf_ptr g = a;
+  ltlf_ptr positive = a;
+  ltlf_ptr negative =
+      context.make_or({context.make_prop_not(a), context.make_end()});
+  for (size_t i = 0; i < depth; ++i) {
+    g = context.make_not(context.make_next(g));
+    auto new_positive = context.make_weak_next(negative);
+    negative = context.make_next(positive);
+    positive = new_positive;
+  }
+  REQUIRE(to_nnf(*g) == positive);
+}
+
+TEST_CASE("Print a very deep formula", "[logic][deep]") {
+  auto context = Context();
+  ltlf_ptr f = context.make_atom("a");
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_next(f);
+  }
+  std::string expected;
+  expected.reserve(depth * 6 + 1);
+  for (size_t i = 0; i < depth; ++i) {
+    expected += "X[!](";
+  }
+  expected += "a";
+  expected.append(depth, ')');
+  REQUIRE(to_string(*f) == expected);
+}
+
+TEST_CASE("Compare very deep formulas", "[logic][deep]") {
+  auto context_1 = Context();
+  auto context_2 = Context();
+  ltlf_ptr f1 = context_1.make_atom("a");
+  ltlf_ptr f2 = context_2.make_atom("a");
+  ltlf_ptr g2 = context_2.make_atom("b");
+  for (size_t i = 0; i < depth; ++i) {
+    f1 = context_1.make_eventually(f1);
+    f2 = context_2.make_eventually(f2);
+    g2 = context_2.make_eventually(g2);
+  }
+  // distinct nodes, since the contexts are different
+  REQUIRE(f1 != f2);
+  REQUIRE(f1->hash() == f2->hash());
+  REQUIRE(*f1 == *f2);
+  REQUIRE(f1->compare(*f2) == 0);
+  REQUIRE(!(*f2 == *g2));
+  REQUIRE(f2->compare(*g2) < 0);
+  REQUIRE(g2->compare(*f2) > 0);
+}
+
+TEST_CASE("Compare very deep until and release chains", "[logic][deep]") {
+  auto context_1 = Context();
+  auto context_2 = Context();
+  auto a1 = context_1.make_atom("a");
+  auto a2 = context_2.make_atom("a");
+  auto b2 = context_2.make_atom("b");
+  // a U (a R (a U ... a)), nested on the right, and the same chain nested
+  // on the left, ending with b in g2
+  ltlf_ptr f1 = a1;
+  ltlf_ptr f2 = a2;
+  ltlf_ptr g2 = b2;
+  ltlf_ptr left_f1 = a1;
+  ltlf_ptr left_f2 = a2;
+  ltlf_ptr left_g2 = b2;
+  for (size_t i = 0; i < depth; ++i) {
+    if (i % 2 == 0) {
+      f1 = context_1.make_until({a1, f1});
+      f2 = context_2.make_until({a2, f2});
+      g2 = context_2.make_until({a2, g2});
+      left_f1 = context_1.make_until({left_f1, a1});
+      left_f2 = context_2.make_until({left_f2, a2});
+      left_g2 = context_2.make_until({left_g2, a2});
+    } else {
+      f1 = context_1.make_release({a1, f1});
+      f2 = context_2.make_release({a2, f2});
+      g2 = context_2.make_release({a2, g2});
+      left_f1 = context_1.make_release({left_f1, a1});
+      left_f2 = context_2.make_release({left_f2, a2});
+      left_g2 = context_2.make_release({left_g2, a2});
+    }
+  }
+  REQUIRE(f1 != f2);
+  REQUIRE(*f1 == *f2);
+  REQUIRE(f1->compare(*f2) == 0);
+  REQUIRE(!(*f2 == *g2));
+  REQUIRE(f2->compare(*g2) != 0);
+  REQUIRE(g2->compare(*f2) == -f2->compare(*g2));
+
+  REQUIRE(*left_f1 == *left_f2);
+  REQUIRE(left_f1->compare(*left_f2) == 0);
+  REQUIRE(!(*left_f2 == *left_g2));
+  REQUIRE(left_f2->compare(*left_g2) != 0);
+  REQUIRE(left_g2->compare(*left_f2) == -left_f2->compare(*left_g2));
+  REQUIRE(!(*f1 == *left_f1));
+}
+
+TEST_CASE("Free a very deep formula", "[logic][deep]") {
+  auto context = Context();
+  auto nb_nodes = context.nb_nodes();
+  ltlf_ptr f = context.make_atom("a");
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_always(f);
+  }
+  f.reset();
+  REQUIRE(context.collect_garbage() == depth + 1);
+  REQUIRE(context.nb_nodes() == nb_nodes);
+
+  // the nodes still alive are freed with the context
+  f = context.make_atom("a");
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_always(f);
+  }
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
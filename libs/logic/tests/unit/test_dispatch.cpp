@@ -0,0 +1,62 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch.hpp>
+#include <cynthia/logic/dispatch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+// returns the type code of the static type selected by dispatch()
+class TypeCodeHandler {
+public:
+  template <typename T> TypeID visit(const T&) { return T::type_code_id; }
+};
+
+TEST_CASE("Dispatch selects the concrete type", "[logic][dispatch]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto handler = TypeCodeHandler{};
+  auto formulas = vec_ptr{context.make_tt(),
+                          context.make_ff(),
+                          context.make_prop_true(),
+                          context.make_prop_false(),
+                          a,
+                          context.make_prop_not(a),
+                          context.make_not(a),
+                          context.make_and({a, b}),
+                          context.make_or({a, b}),
+                          context.make_implies({a, b}),
+                          context.make_equivalent({a, b}),
+                          context.make_xor({a, b}),
+                          context.make_next(a),
+                          context.make_weak_next(a),
+                          context.make_until({a, b}),
+                          context.make_release({a, b}),
+                          context.make_eventually(a),
+                          context.make_always(a)};
+  for (const auto& formula : formulas) {
+    REQUIRE(dispatch(*formula, handler) == formula->get_type_code());
+  }
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
@@ -18,6 +18,7 @@
 #include <catch.hpp>
 #include <cynthia/logic/hashtable.hpp>
 #include <cynthia/logic/ltlf.hpp>
+#include <thread>
 
 namespace cynthia {
 namespace logic {
@@ -43,6 +44,72 @@ TEST_CASE("Create hash table", "[logic][hashtable]") {
   REQUIRE(*actual_element_1_ptr_b == *expected_element_1_ptr);
   REQUIRE(actual_element_1_ptr_b == expected_element_1_ptr);
 }
+
+TEST_CASE("Concurrent hash consing", "[logic][hashtable]") {
+  auto context = Context();
+  const size_t nb_threads = 8;
+  const size_t nb_atoms = 200;
+  std::vector<vec_ptr> results(nb_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nb_threads; ++t) {
+    threads.emplace_back([&context, &results, t]() {
+      // each thread builds the same formulas, in a different order
+      for (size_t j = 0; j < nb_atoms; ++j) {
+        auto i = (j + t * 17) % nb_atoms;
+        auto a = context.make_atom("a" + std::to_string(i));
+        auto b = context.make_atom("b" + std::to_string(i));
+        auto f = context.make_until({a, context.make_next(b)});
+        results[t].push_back(context.make_and({f, context.make_not(a)}));
+      }
+      std::rotate(results[t].begin(),
+                  results[t].begin() + (nb_atoms - (t * 17) % nb_atoms) %
+                                           nb_atoms,
+                  results[t].end());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // node identity is canonical across threads
+  for (size_t t = 1; t < nb_threads; ++t) {
+    REQUIRE(results[t] == results[0]);
+  }
+  REQUIRE(context.nb_symbols() == 2 * nb_atoms);
+  const auto& atom = static_cast<const LTLfAtom&>(*context.make_atom("b7"));
+  REQUIRE(context.symbols().get_name(atom.symbol_id) == "b7");
+}
+
+TEST_CASE("Garbage collection of interned nodes", "[logic][hashtable]") {
+  auto context = Context();
+  auto baseline = context.nb_nodes();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto kept = context.make_until({a, b});
+  auto kept_nodes = context.nb_nodes();
+
+  {
+    // transient formulas, dropped at the end of the scope
+    auto f = kept;
+    for (size_t i = 0; i < 100; ++i) {
+      f = context.make_or({context.make_next(f), context.make_atom("c")});
+    }
+    REQUIRE(context.nb_nodes() > kept_nodes);
+  }
+  // the whole transient chain is freed in a single sweep
+  REQUIRE(context.collect_garbage() == 201);
+  REQUIRE(context.nb_nodes() == kept_nodes);
+  REQUIRE(context.collect_garbage() == 0);
+
+  // live nodes are still canonical
+  REQUIRE(context.make_until({a, b}) == kept);
+
+  a.reset();
+  b.reset();
+  kept.reset();
+  REQUIRE(context.collect_garbage() == 3);
+  REQUIRE(context.nb_nodes() == baseline);
+}
 } // namespace Test
 } // namespace logic
 } // namespace cynthia
\ No newline at end of file
@@ -15,6 +15,7 @@
  * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <catch.hpp>
 #include <cynthia/logic/ltlf.hpp>
 
@@ -302,6 +303,35 @@ TEST_CASE("last", "[logic][ltlf]") {
   REQUIRE(*actual_last == *expected_last);
 }
 
+TEST_CASE("n-ary and/or in canonical order", "[logic][ltlf]") {
+  auto context = Context();
+  vec_ptr atoms;
+  for (size_t i = 0; i < 10; ++i) {
+    atoms.push_back(context.make_atom("a_" + std::to_string(i)));
+  }
+  auto sorted = vec_ptr(atoms);
+  std::sort(sorted.begin(), sorted.end(), utils::Deref::Less());
+  auto reversed = vec_ptr(sorted.rbegin(), sorted.rend());
+
+  // the canonical order takes the fast path, with the same result
+  REQUIRE(context.make_and(sorted) == context.make_and(reversed));
+  REQUIRE(context.make_or(sorted) == context.make_or(reversed));
+  const auto& conjunction =
+      static_cast<const LTLfAnd&>(*context.make_and(reversed));
+  REQUIRE(conjunction.args == sorted);
+
+  // duplicates, constants and nested operators are still normalized
+  auto duplicates = vec_ptr{sorted[0], sorted[0], sorted[1]};
+  REQUIRE(context.make_and(duplicates) ==
+          context.make_and({sorted[0], sorted[1]}));
+  auto with_tt = vec_ptr{context.make_tt(), sorted[0], sorted[1]};
+  REQUIRE(context.make_and(with_tt) ==
+          context.make_and({sorted[0], sorted[1]}));
+  REQUIRE(context.make_or(with_tt) == context.make_tt());
+  auto nested = vec_ptr{context.make_and({sorted[0], sorted[1]}), sorted[2]};
+  REQUIRE(context.make_and(nested) ==
+          context.make_and({sorted[0], sorted[1], sorted[2]}));
+}
 } // namespace Test
 } // namespace logic
 } // namespace cynthia
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/nnf.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+// f_0 = a, f_{i+1} = X(f_i) | WX(f_i): linear as a DAG, exponential as a tree
+static ltlf_ptr make_shared_chain(Context& context, size_t depth) {
+  ltlf_ptr f = context.make_atom("a");
+  for (size_t i = 0; i < depth; ++i) {
+    f = context.make_or({context.make_next(f), context.make_weak_next(f)});
+  }
+  return f;
+}
+
+TEST_CASE("Memoizing visitor visits shared nodes once",
+          "[logic][memoizing_visitor]") {
+  auto context = Context();
+  const size_t depth = 64;
+  auto f = make_shared_chain(context, depth);
+
+  auto visitor = NNFTransformer{};
+  auto actual_formula = visitor.apply(*f);
+  REQUIRE(actual_formula == f);
+  auto stats = visitor.cache_stats();
+  REQUIRE(stats.misses == 3 * depth + 1);
+  // the arguments are computed before their parent is visited, so every
+  // edge of the DAG (two from each Or, one from each X and WX) is a hit
+  REQUIRE(stats.hits == 4 * depth);
+  REQUIRE(stats.size == stats.misses);
+
+  // a second application is served entirely from the cache
+  REQUIRE(visitor.apply(*f) == f);
+  REQUIRE(visitor.cache_stats().hits == 4 * depth + 1);
+
+  visitor.clear_cache();
+  REQUIRE(visitor.cache_stats().size == 0);
+  REQUIRE(visitor.cache_stats().hits == 0);
+}
+
+TEST_CASE("Memoizing visitor on negated shared formula",
+          "[logic][memoizing_visitor]") {
+  auto context = Context();
+  const size_t depth = 64;
+  auto f = make_shared_chain(context, depth);
+  auto not_a = context.make_not(context.make_atom("a"));
+  auto expected_formula = to_nnf(*not_a);
+  for (size_t i = 0; i < depth; ++i) {
+    expected_formula =
+        context.make_and({context.make_weak_next(expected_formula),
+                          context.make_next(expected_formula)});
+  }
+  auto actual_formula = to_nnf(*context.make_not(f));
+  REQUIRE(actual_formula == expected_formula);
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
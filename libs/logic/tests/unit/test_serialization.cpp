@@ -0,0 +1,110 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cstdio>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/print.hpp>
+#include <cynthia/logic/serialization.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+static std::string to_binary(const LTLfFormula& formula) {
+  std::ostringstream out;
+  write_binary(formula, out);
+  return out.str();
+}
+
+TEST_CASE("Test binary round trip", "[serialization]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto formula = context.make_and(
+      {context.make_always(context.make_implies({a, context.make_next(b)})),
+       context.make_until({a, context.make_prop_not(b), context.make_tt()}),
+       context.make_not(context.make_equivalent({a, b})),
+       context.make_xor({context.make_weak_next(a), context.make_prop_true()}),
+       context.make_release({context.make_ff(), context.make_prop_false()}),
+       context.make_eventually(context.make_last())});
+  auto data = to_binary(*formula);
+
+  SECTION("same context") {
+    REQUIRE(read_binary(context, data.data(), data.size()) == formula);
+  }
+  SECTION("other context") {
+    auto other_context = Context();
+    auto result = read_binary(other_context, data.data(), data.size());
+    REQUIRE(&result->ctx() == &other_context);
+    REQUIRE(to_string(*result) == to_string(*formula));
+    REQUIRE(other_context.nb_symbols() == 2);
+  }
+}
+
+TEST_CASE("Test binary format writes shared nodes once", "[serialization]") {
+  auto context = Context();
+  // f_{i+1} = f_i U X f_i: the tree is exponential in the depth
+  ltlf_ptr f = context.make_atom("a");
+  for (size_t i = 0; i < 40; ++i) {
+    f = context.make_until({f, context.make_next(f)});
+  }
+  auto data = to_binary(*f);
+  REQUIRE(data.size() < 1000);
+
+  auto other_context = Context();
+  auto result = read_binary(other_context, data.data(), data.size());
+  REQUIRE(result->tree_size() == f->tree_size());
+}
+
+TEST_CASE("Test binary format rejects invalid data", "[serialization]") {
+  auto context = Context();
+  auto formula =
+      context.make_or({context.make_atom("a"), context.make_atom("b")});
+  auto data = to_binary(*formula);
+
+  std::string bad_magic = "X" + data.substr(1);
+  REQUIRE_THROWS_AS(read_binary(context, bad_magic.data(), bad_magic.size()),
+                    std::runtime_error);
+  for (size_t size = 0; size < data.size(); ++size) {
+    REQUIRE_THROWS_AS(read_binary(context, data.data(), size),
+                      std::runtime_error);
+  }
+  auto trailing = data + "x";
+  REQUIRE_THROWS_AS(read_binary(context, trailing.data(), trailing.size()),
+                    std::runtime_error);
+}
+
+TEST_CASE("Test binary files", "[serialization]") {
+  auto context = Context();
+  auto formula = context.make_eventually(context.make_atom("a"));
+  const std::string filename = "test_serialization.ltlfb";
+  save_binary(*formula, filename);
+  REQUIRE(is_binary_file(filename));
+  auto result = load_binary(context, filename);
+  REQUIRE(result == formula);
+  std::ofstream(filename) << "F(a)";
+  REQUIRE_FALSE(is_binary_file(filename));
+  std::remove(filename.c_str());
+  REQUIRE_THROWS_AS(load_binary(context, "does/not/exist"),
+                    std::runtime_error);
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
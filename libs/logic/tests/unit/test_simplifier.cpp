@@ -0,0 +1,160 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/simplifier.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+TEST_CASE("Test simplifier temporal absorption", "[simplifier]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto f_a = context.make_eventually(a);
+  auto g_a = context.make_always(a);
+  auto a_until_b = context.make_until({a, b});
+  auto a_release_b = context.make_release({a, b});
+
+  REQUIRE(simplify_formula(*context.make_eventually(f_a)) == f_a);
+  REQUIRE(simplify_formula(*context.make_always(g_a)) == g_a);
+  REQUIRE(simplify_formula(*context.make_until({a, a_until_b})) ==
+          a_until_b);
+  REQUIRE(simplify_formula(*context.make_release({a, a_release_b})) ==
+          a_release_b);
+  // different operators do not absorb each other
+  auto g_f_a = context.make_always(f_a);
+  REQUIRE(simplify_formula(*g_f_a) == g_f_a);
+}
+
+TEST_CASE("Test simplifier next distribution", "[simplifier]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto x_a = context.make_next(a);
+  auto x_b = context.make_next(b);
+  auto wx_b = context.make_weak_next(b);
+  auto a_and_b = context.make_and({a, b});
+  auto a_or_b = context.make_or({a, b});
+
+  REQUIRE(simplify_formula(*context.make_and({x_a, x_b})) ==
+          context.make_next(a_and_b));
+  REQUIRE(simplify_formula(*context.make_and({x_a, wx_b})) ==
+          context.make_next(a_and_b));
+  REQUIRE(simplify_formula(*context.make_and(
+              {context.make_weak_next(a), wx_b})) ==
+          context.make_weak_next(a_and_b));
+  REQUIRE(simplify_formula(*context.make_or({x_a, x_b})) ==
+          context.make_next(a_or_b));
+  REQUIRE(simplify_formula(*context.make_or({x_a, wx_b})) ==
+          context.make_weak_next(a_or_b));
+  // the other arguments are kept
+  REQUIRE(simplify_formula(*context.make_and({c, x_a, x_b})) ==
+          context.make_and({c, context.make_next(a_and_b)}));
+  // the merged argument is simplified as well
+  REQUIRE(simplify_formula(*context.make_and(
+              {x_a, context.make_next(context.make_prop_not(a))})) ==
+          context.make_ff());
+}
+
+TEST_CASE("Test simplifier constant propagation", "[simplifier]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto not_a = context.make_prop_not(a);
+  auto x_a = context.make_next(a);
+  auto tt = context.make_tt();
+  auto ff = context.make_ff();
+  auto prop_true = context.make_prop_true();
+  auto prop_false = context.make_prop_false();
+
+  REQUIRE(simplify_formula(*context.make_next(ff)) == ff);
+  REQUIRE(simplify_formula(*context.make_weak_next(tt)) == tt);
+  REQUIRE(simplify_formula(*context.make_eventually(prop_false)) == ff);
+  REQUIRE(simplify_formula(*context.make_always(tt)) == tt);
+  REQUIRE(simplify_formula(*context.make_until({a, ff})) == ff);
+  REQUIRE(simplify_formula(*context.make_release({a, tt})) == tt);
+  REQUIRE(simplify_formula(*context.make_until({tt, a})) ==
+          context.make_eventually(a));
+  REQUIRE(simplify_formula(*context.make_release({ff, a})) ==
+          context.make_always(a));
+
+  REQUIRE(simplify_formula(*context.make_and({a, not_a})) == ff);
+  REQUIRE(simplify_formula(*context.make_or({a, not_a})) == prop_true);
+  REQUIRE(simplify_formula(*context.make_and({a, prop_false})) == ff);
+  REQUIRE(simplify_formula(*context.make_and({prop_true, x_a})) == x_a);
+  REQUIRE(simplify_formula(*context.make_or({prop_true, x_a})) == prop_true);
+  // G ff accepts the empty trace, where true does not hold
+  auto end = context.make_end();
+  auto true_and_end = context.make_and({prop_true, end});
+  REQUIRE(simplify_formula(*true_and_end) == true_and_end);
+
+  // the markers of the end of the trace are kept
+  REQUIRE(simplify_formula(*end) == end);
+  REQUIRE(simplify_formula(*context.make_not_end()) == context.make_not_end());
+  REQUIRE(simplify_formula(*context.make_last()) == context.make_last());
+}
+
+TEST_CASE("Test simplifier subsumption", "[simplifier]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto a_or_b = context.make_or({a, b});
+  auto a_and_b = context.make_and({a, b});
+
+  REQUIRE(simplify_formula(*context.make_and({a, a_or_b})) == a);
+  REQUIRE(simplify_formula(*context.make_or({a, a_and_b})) == a);
+  REQUIRE(simplify_formula(*context.make_and(
+              {a_or_b, context.make_or({a, b, c})})) == a_or_b);
+  REQUIRE(simplify_formula(*context.make_or(
+              {a_and_b, context.make_and({a, b, c})})) == a_and_b);
+  // not subsumed
+  auto f = context.make_and({c, a_or_b});
+  REQUIRE(simplify_formula(*f) == f);
+  // also below temporal operators
+  REQUIRE(simplify_formula(*context.make_always(
+              context.make_and({a, a_or_b}))) == context.make_always(a));
+}
+
+TEST_CASE("Test simplifier options", "[simplifier]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto f_f_a = context.make_eventually(context.make_eventually(a));
+  auto x_a_and_x_b =
+      context.make_and({context.make_next(a), context.make_next(b)});
+  auto a_and_a_or_b = context.make_and({a, context.make_or({a, b})});
+  auto x_ff = context.make_next(context.make_ff());
+
+  auto options = SimplifierOptions{};
+  options.temporal_absorption = false;
+  REQUIRE(simplify_formula(*f_f_a, options) == f_f_a);
+  options.next_distribution = false;
+  REQUIRE(simplify_formula(*x_a_and_x_b, options) == x_a_and_x_b);
+  options.subsumption = false;
+  REQUIRE(simplify_formula(*a_and_a_or_b, options) == a_and_a_or_b);
+  options.constant_propagation = false;
+  REQUIRE_FALSE(options.any());
+  REQUIRE(simplify_formula(*x_ff, options) == x_ff);
+  REQUIRE(simplify_formula(*x_ff) == context.make_ff());
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/symbol_table.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+TEST_CASE("Symbol table", "[logic][symbol_table]") {
+  auto table = SymbolTable{};
+  REQUIRE(table.size() == 0);
+
+  // ids are dense, in insertion order
+  REQUIRE(table.add("a") == 0);
+  REQUIRE(table.add("b") == 1);
+  // the same name is interned only once
+  REQUIRE(table.add("a") == 0);
+  REQUIRE(table.size() == 2);
+
+  REQUIRE(table.contains("b"));
+  REQUIRE(!table.contains("c"));
+  REQUIRE(table.get_id("b") == 1);
+  REQUIRE(table.get_name(1) == "b");
+  REQUIRE_THROWS_AS(table.get_id("c"), std::invalid_argument);
+  REQUIRE_THROWS_AS(table.get_name(2), std::invalid_argument);
+}
+
+TEST_CASE("Atom symbol ids", "[logic][symbol_table]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto a_again = context.make_atom("a");
+
+  const auto& atom_a = static_cast<const LTLfAtom&>(*a);
+  const auto& atom_b = static_cast<const LTLfAtom&>(*b);
+  REQUIRE(a == a_again);
+  REQUIRE(atom_a.symbol_id != atom_b.symbol_id);
+  REQUIRE(context.nb_symbols() == 2);
+  REQUIRE(context.symbols().get_name(atom_a.symbol_id) == "a");
+  REQUIRE(context.symbols().get_id("b") == atom_b.symbol_id);
+}
+
+TEST_CASE("Atoms of different contexts", "[logic][symbol_table]") {
+  auto context_1 = Context();
+  auto context_2 = Context();
+  context_2.make_atom("b");
+  auto a1 = context_1.make_atom("a");
+  auto a2 = context_2.make_atom("a");
+
+  // different symbol ids, but equal atoms with the same hash
+  REQUIRE(static_cast<const LTLfAtom&>(*a1).symbol_id !=
+          static_cast<const LTLfAtom&>(*a2).symbol_id);
+  REQUIRE(*a1 == *a2);
+  REQUIRE(a1->compare(*a2) == 0);
+  REQUIRE(a1->hash() == a2->hash());
+}
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
@@ -0,0 +1,138 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/logic/trace_evaluator.hpp>
+
+namespace cynthia {
+namespace logic {
+namespace Test {
+
+TEST_CASE("Test trace evaluator on the empty trace", "[trace_evaluator]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto empty = trace_t{};
+
+  REQUIRE(TraceEvaluator(*context.make_tt()).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_ff()).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_prop_true()).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*a).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_prop_not(a)).evaluate(empty));
+  REQUIRE(TraceEvaluator(*context.make_end()).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_not_end()).evaluate(empty));
+  REQUIRE(TraceEvaluator(*context.make_always(a)).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_eventually(a)).evaluate(empty));
+  REQUIRE(TraceEvaluator(*context.make_weak_next(a)).evaluate(empty));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_next(a)).evaluate(empty));
+}
+
+TEST_CASE("Test trace evaluator on a trace", "[trace_evaluator]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto id_a = context.symbols().get_id("a");
+  auto id_b = context.symbols().get_id("b");
+  // a, a, b
+  auto trace = trace_t{{id_a}, {id_a}, {id_b}};
+
+  REQUIRE(TraceEvaluator(*a).evaluate(trace));
+  REQUIRE_FALSE(TraceEvaluator(*b).evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_until({a, b})).evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_until({b, a, b})).evaluate(trace));
+  auto a_and_b = context.make_and({a, b});
+  REQUIRE_FALSE(
+      TraceEvaluator(*context.make_until({a, a_and_b})).evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_next(a)).evaluate(trace));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_next(context.make_next(
+                                   context.make_next(b))))
+                    .evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_next(context.make_next(
+                             context.make_last())))
+              .evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_eventually(b)).evaluate(trace));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_always(a)).evaluate(trace));
+  REQUIRE_FALSE(TraceEvaluator(*context.make_release({b, a})).evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_release({b, context.make_or({a, b})}))
+              .evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_not(context.make_always(a)))
+              .evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_implies({b, a})).evaluate(trace));
+  REQUIRE_FALSE(
+      TraceEvaluator(*context.make_equivalent({a, b})).evaluate(trace));
+  REQUIRE(TraceEvaluator(*context.make_xor({a, b})).evaluate(trace));
+  // atoms that are not in the trace alphabet never hold
+  auto c = context.make_atom("c");
+  REQUIRE(TraceEvaluator(*context.make_always(context.make_prop_not(c)))
+              .evaluate(trace));
+}
+
+TEST_CASE("Test trace evaluator batches", "[trace_evaluator]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto id_a = context.symbols().get_id("a");
+  auto id_b = context.symbols().get_id("b");
+  // G(a -> X[!] b): every a is followed by b
+  auto formula = context.make_always(
+      context.make_or({context.make_prop_not(a), context.make_next(b)}));
+  auto evaluator = TraceEvaluator(*formula);
+
+  // more than one batch, traces of different lengths
+  std::vector<trace_t> traces;
+  std::vector<bool> expected;
+  for (size_t n = 0; n < 2 * TraceEvaluator::batch_size + 3; ++n) {
+    auto length = n % 7;
+    auto trace = trace_t(length);
+    bool holds = true;
+    for (size_t i = 0; i < length; ++i) {
+      bool has_a = (n >> i) & 1;
+      bool has_b = (n >> (i + 1)) & 1;
+      if (has_a) {
+        trace[i].push_back(id_a);
+      }
+      if (has_b) {
+        trace[i].push_back(id_b);
+      }
+    }
+    for (size_t i = 0; i < length; ++i) {
+      bool has_a = (n >> i) & 1;
+      bool next_has_b = i + 1 < length and ((n >> (i + 2)) & 1);
+      holds = holds and (!has_a or next_has_b);
+    }
+    traces.push_back(trace);
+    expected.push_back(holds);
+  }
+
+  auto results = evaluator.evaluate(traces);
+  REQUIRE(results == expected);
+  for (size_t n = 0; n < traces.size(); n += 37) {
+    REQUIRE(evaluator.evaluate(traces[n]) == expected[n]);
+  }
+}
+
+TEST_CASE("Test trace evaluator shares subformulas", "[trace_evaluator]") {
+  auto context = Context();
+  auto a = context.make_atom("a");
+  auto f_a = context.make_eventually(a);
+  auto formula = context.make_and({f_a, context.make_next(f_a)});
+  // a, F a, X F a and the conjunction
+  REQUIRE(TraceEvaluator(*formula).program_size() == 4);
+}
+
+} // namespace Test
+} // namespace logic
+} // namespace cynthia
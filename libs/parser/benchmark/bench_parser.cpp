@@ -0,0 +1,61 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/parser/driver.hpp>
+#include <cynthia/parser/string_parser.hpp>
+#include <sstream>
+#include <string>
+
+namespace cynthia {
+namespace parser {
+namespace Benchmark {
+
+// a conjunction of request-response and mutual exclusion clauses
+static std::string make_spec(size_t n) {
+  std::string text = "tt";
+  for (size_t i = 0; i < n; ++i) {
+    auto index = std::to_string(i);
+    auto next_index = std::to_string(i + 1);
+    text += " & G(req_" + index + " -> X[!](F(grant_" + index + ")))";
+    text += " & G(!(grant_" + index + " & grant_" + next_index + "))";
+    text += " & (busy_" + index + " U (grant_" + index + " | last))";
+  }
+  return text;
+}
+
+// the throughput in MB/s is the size of the text over the mean time
+TEST_CASE("Benchmark parsers", "[parser][benchmark]") {
+  auto n = GENERATE(100, 1000);
+  auto text = make_spec(n);
+  auto suffix = ", " + std::to_string(text.size()) + " bytes";
+
+  BENCHMARK("flex/bison driver" + suffix) {
+    auto driver = ltlf::LTLfDriver();
+    std::istringstream stream(text);
+    driver.parse(stream);
+    return driver.get_result()->hash();
+  };
+  BENCHMARK("string parser" + suffix) {
+    auto context = logic::Context();
+    return ltlf::parse_formula(context, text)->hash();
+  };
+}
+
+} // namespace Benchmark
+} // namespace parser
+} // namespace cynthia
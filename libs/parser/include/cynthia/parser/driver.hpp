@@ -73,8 +73,10 @@ public:
   logic::ltlf_ptr add_LTLfNot(const logic::ltlf_ptr& arg) const;
   logic::ltlf_ptr add_LTLfAnd(const logic::ltlf_ptr& lhs,
                               const logic::ltlf_ptr& rhs) const;
+  logic::ltlf_ptr add_LTLfAnd(const logic::vec_ptr& args) const;
   logic::ltlf_ptr add_LTLfOr(const logic::ltlf_ptr& lhs,
                              const logic::ltlf_ptr& rhs) const;
+  logic::ltlf_ptr add_LTLfOr(const logic::vec_ptr& args) const;
   logic::ltlf_ptr add_LTLfEquivalent(const logic::ltlf_ptr& lhs,
                                      const logic::ltlf_ptr& rhs) const;
   logic::ltlf_ptr add_LTLfImplies(const logic::ltlf_ptr& lhs,
@@ -24,6 +24,7 @@ namespace ltlf {
 
 struct LTLf_YYSTYPE {
   logic::ltlf_ptr formula;
+  logic::vec_ptr formulas;
   std::string symbol_name;
 
   // Constructor
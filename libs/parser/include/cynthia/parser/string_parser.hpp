@@ -0,0 +1,57 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <string_view>
+
+#include <cynthia/logic/base.hpp>
+
+namespace cynthia {
+namespace parser {
+namespace ltlf {
+
+/*
+ * Hand-written parser for the same language as LTLfDriver (see lexer.l and
+ * parser.yy), with the same operator precedences and the same resulting
+ * formulas.
+ *
+ * The parser is an operator-precedence parser with explicit stacks: it
+ * keeps all its state in local variables, so any number of threads can
+ * parse at the same time into a shared Context, and deeply nested formulas
+ * do not overflow the call stack. Atom names are interned once per parse.
+ * Unlike the flex scanner, newlines are plain whitespace, and unknown
+ * characters are errors instead of being skipped.
+ */
+
+/**
+ * Parse a formula from its text.
+ * @throw std::invalid_argument on syntax errors, with the line and column
+ */
+logic::ltlf_ptr parse_formula(logic::Context& context, std::string_view text);
+
+/**
+ * Parse a formula from a file, mapped in memory.
+ * @throw std::runtime_error if the file cannot be read
+ * @throw std::invalid_argument on syntax errors
+ */
+logic::ltlf_ptr parse_formula_file(logic::Context& context,
+                                   const std::string& filename);
+
+} // namespace ltlf
+} // namespace parser
+} // namespace cynthia
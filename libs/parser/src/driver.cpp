@@ -105,11 +105,19 @@ logic::ltlf_ptr LTLfDriver::add_LTLfAnd(const logic::ltlf_ptr& lhs,
   return context->make_and(logic::vec_ptr{lhs, rhs});
 }
 
+logic::ltlf_ptr LTLfDriver::add_LTLfAnd(const logic::vec_ptr& args) const {
+  return context->make_and(args);
+}
+
 logic::ltlf_ptr LTLfDriver::add_LTLfOr(const logic::ltlf_ptr& lhs,
                                        const logic::ltlf_ptr& rhs) const {
   return context->make_or(logic::vec_ptr{lhs, rhs});
 }
 
+logic::ltlf_ptr LTLfDriver::add_LTLfOr(const logic::vec_ptr& args) const {
+  return context->make_or(args);
+}
+
 logic::ltlf_ptr LTLfDriver::add_LTLfImplies(const logic::ltlf_ptr& lhs,
                                             const logic::ltlf_ptr& rhs) const {
   return context->make_implies(logic::vec_ptr{lhs, rhs});
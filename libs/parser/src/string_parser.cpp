@@ -0,0 +1,368 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/mapped_file.hpp>
+#include <cynthia/parser/string_parser.hpp>
+
+namespace cynthia {
+namespace parser {
+namespace ltlf {
+
+namespace {
+
+enum class Token {
+  End,
+  LeftParenthesis,
+  RightParenthesis,
+  // leaves
+  Symbol,
+  True,
+  False,
+  PropTrue,
+  PropFalse,
+  Last,
+  EndOfTrace,
+  // prefix operators
+  Next,
+  WeakNext,
+  Eventually,
+  Always,
+  Not,
+  // infix operators, from the lowest to the highest precedence
+  Equivalence,
+  Implication,
+  Xor,
+  Or,
+  And,
+  Until,
+  Release
+};
+
+bool is_leaf(Token token) {
+  return Token::Symbol <= token and token <= Token::EndOfTrace;
+}
+
+bool is_prefix(Token token) {
+  return Token::Next <= token and token <= Token::Not;
+}
+
+bool is_infix(Token token) { return Token::Equivalence <= token; }
+
+// prefix operators bind tighter than all the infix ones
+int precedence(Token token) {
+  return is_prefix(token) ? 100 : static_cast<int>(token);
+}
+
+bool is_right_associative(Token token) {
+  return token == Token::Equivalence or token == Token::Implication or
+         token == Token::Xor;
+}
+
+// and/or chains become a single n-ary node, as in parser.yy
+bool is_chain(Token token) { return token == Token::And or token == Token::Or; }
+
+bool is_symbol_start(char c) { return ('a' <= c and c <= 'z') or c == '_'; }
+
+bool is_symbol_char(char c) {
+  return is_symbol_start(c) or ('0' <= c and c <= '9');
+}
+
+class Lexer {
+private:
+  std::string_view text_;
+  size_t position_ = 0;
+
+public:
+  explicit Lexer(std::string_view text) : text_{text} {}
+
+  // where the last token starts, and its text
+  size_t offset = 0;
+  std::string_view lexeme;
+
+  Token next() {
+    while (position_ < text_.size() and
+           (text_[position_] == ' ' or text_[position_] == '\t' or
+            text_[position_] == '\r' or text_[position_] == '\n')) {
+      ++position_;
+    }
+    offset = position_;
+    if (position_ == text_.size()) {
+      lexeme = {};
+      return Token::End;
+    }
+    auto rest = text_.substr(position_);
+    auto accept = [this, &rest](Token token, size_t length) {
+      lexeme = rest.substr(0, length);
+      position_ += length;
+      return token;
+    };
+    auto starts_with = [&rest](std::string_view prefix) {
+      return rest.substr(0, prefix.size()) == prefix;
+    };
+    switch (rest[0]) {
+    case '(':
+      return accept(Token::LeftParenthesis, 1);
+    case ')':
+      return accept(Token::RightParenthesis, 1);
+    case 'X':
+      return starts_with("X[!]") ? accept(Token::Next, 4)
+                                 : accept(Token::WeakNext, 1);
+    case 'U':
+      return accept(Token::Until, 1);
+    case 'R':
+    case 'V':
+      return accept(Token::Release, 1);
+    case 'F':
+      return accept(Token::Eventually, 1);
+    case 'G':
+      return accept(Token::Always, 1);
+    case '^':
+      return accept(Token::Xor, 1);
+    case '!':
+    case '~':
+      return accept(Token::Not, 1);
+    case '&':
+      return accept(Token::And, starts_with("&&") ? 2 : 1);
+    case '|':
+      return accept(Token::Or, starts_with("||") ? 2 : 1);
+    case '<':
+      if (starts_with("<=>") or starts_with("<->")) {
+        return accept(Token::Equivalence, 3);
+      }
+      break;
+    case '=':
+    case '-':
+      if (starts_with("=>") or starts_with("->")) {
+        return accept(Token::Implication, 2);
+      }
+      break;
+    default:
+      if (is_symbol_start(rest[0])) {
+        size_t length = 1;
+        while (length < rest.size() and is_symbol_char(rest[length])) {
+          ++length;
+        }
+        auto word = rest.substr(0, length);
+        if (word == "tt") {
+          return accept(Token::True, length);
+        } else if (word == "ff") {
+          return accept(Token::False, length);
+        } else if (word == "true") {
+          return accept(Token::PropTrue, length);
+        } else if (word == "false") {
+          return accept(Token::PropFalse, length);
+        } else if (word == "last") {
+          return accept(Token::Last, length);
+        } else if (word == "end") {
+          return accept(Token::EndOfTrace, length);
+        }
+        return accept(Token::Symbol, length);
+      }
+    }
+    lexeme = rest.substr(0, 1);
+    throw error("unexpected character '" + std::string(lexeme) + "'");
+  }
+
+  std::invalid_argument error(const std::string& message) const {
+    size_t line = 1;
+    size_t column = 1;
+    for (size_t i = 0; i < offset; ++i) {
+      if (text_[i] == '\n') {
+        ++line;
+        column = 1;
+      } else {
+        ++column;
+      }
+    }
+    return std::invalid_argument("syntax error at line " +
+                                 std::to_string(line) + ", column " +
+                                 std::to_string(column) + ": " + message);
+  }
+};
+
+struct PendingOperator {
+  Token token;
+  // the number of operands of an and/or chain
+  size_t arity;
+};
+
+class Parser {
+private:
+  logic::Context& context_;
+  Lexer lexer_;
+  std::vector<logic::ltlf_ptr> operands_;
+  std::vector<PendingOperator> operators_;
+  std::unordered_map<std::string_view, logic::ltlf_ptr> atoms_;
+
+  logic::ltlf_ptr make_leaf_(Token token) {
+    switch (token) {
+    case Token::True:
+      return context_.make_tt();
+    case Token::False:
+      return context_.make_ff();
+    case Token::PropTrue:
+      return context_.make_prop_true();
+    case Token::PropFalse:
+      return context_.make_prop_false();
+    case Token::Last:
+      return context_.make_last();
+    case Token::EndOfTrace:
+      return context_.make_end();
+    default: {
+      auto& atom = atoms_[lexer_.lexeme];
+      if (!atom) {
+        atom = context_.make_atom(std::string(lexer_.lexeme));
+      }
+      return atom;
+    }
+    }
+  }
+
+  // pop the operands of the operator on top of the stack, and push the
+  // result of the operator
+  void reduce_() {
+    auto pending = operators_.back();
+    operators_.pop_back();
+    if (is_prefix(pending.token)) {
+      auto arg = std::move(operands_.back());
+      operands_.pop_back();
+      operands_.push_back(make_prefix_(pending.token, arg));
+      return;
+    }
+    auto args =
+        logic::vec_ptr(operands_.end() - pending.arity, operands_.end());
+    operands_.resize(operands_.size() - pending.arity);
+    operands_.push_back(make_infix_(pending.token, args));
+  }
+
+  logic::ltlf_ptr make_prefix_(Token token, const logic::ltlf_ptr& arg) {
+    switch (token) {
+    case Token::Next:
+      return context_.make_next(arg);
+    case Token::WeakNext:
+      return context_.make_weak_next(arg);
+    case Token::Eventually:
+      return context_.make_eventually(arg);
+    case Token::Always:
+      return context_.make_always(arg);
+    default:
+      return context_.make_not_unified(arg);
+    }
+  }
+
+  logic::ltlf_ptr make_infix_(Token token, const logic::vec_ptr& args) {
+    switch (token) {
+    case Token::Equivalence:
+      return context_.make_equivalent(args);
+    case Token::Implication:
+      return context_.make_implies(args);
+    case Token::Xor:
+      return context_.make_xor(args);
+    case Token::Or:
+      return context_.make_or(args);
+    case Token::And:
+      return context_.make_and(args);
+    case Token::Until:
+      return context_.make_until(args);
+    default:
+      return context_.make_release(args);
+    }
+  }
+
+  void push_infix_(Token token) {
+    while (!operators_.empty() and
+           operators_.back().token != Token::LeftParenthesis) {
+      auto& top = operators_.back();
+      auto top_precedence = precedence(top.token);
+      if (top.token == token and is_chain(token)) {
+        ++top.arity;
+        return;
+      }
+      if (top_precedence < precedence(token) or
+          (top_precedence == precedence(token) and
+           is_right_associative(token))) {
+        break;
+      }
+      reduce_();
+    }
+    operators_.push_back(PendingOperator{token, 2});
+  }
+
+public:
+  Parser(logic::Context& context, std::string_view text)
+      : context_{context}, lexer_{text} {}
+
+  logic::ltlf_ptr parse() {
+    bool expect_operand = true;
+    while (true) {
+      auto token = lexer_.next();
+      if (expect_operand) {
+        if (is_leaf(token)) {
+          operands_.push_back(make_leaf_(token));
+          expect_operand = false;
+        } else if (is_prefix(token) or token == Token::LeftParenthesis) {
+          operators_.push_back(PendingOperator{token, 1});
+        } else {
+          throw lexer_.error(token == Token::End ? "unexpected end of input"
+                                                 : "expected a formula");
+        }
+      } else if (is_infix(token)) {
+        push_infix_(token);
+        expect_operand = true;
+      } else if (token == Token::RightParenthesis) {
+        while (!operators_.empty() and
+               operators_.back().token != Token::LeftParenthesis) {
+          reduce_();
+        }
+        if (operators_.empty()) {
+          throw lexer_.error("unbalanced ')'");
+        }
+        operators_.pop_back();
+      } else if (token == Token::End) {
+        while (!operators_.empty()) {
+          if (operators_.back().token == Token::LeftParenthesis) {
+            throw lexer_.error("missing ')'");
+          }
+          reduce_();
+        }
+        return operands_.back();
+      } else {
+        throw lexer_.error("expected an operator");
+      }
+    }
+  }
+};
+
+} // namespace
+
+logic::ltlf_ptr parse_formula(logic::Context& context, std::string_view text) {
+  return Parser(context, text).parse();
+}
+
+logic::ltlf_ptr parse_formula_file(logic::Context& context,
+                                   const std::string& filename) {
+  auto file = utils::MappedFile(filename);
+  return parse_formula(context, file.view());
+}
+
+} // namespace ltlf
+} // namespace parser
+} // namespace cynthia
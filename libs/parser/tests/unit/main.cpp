@@ -225,6 +225,35 @@ TEST_CASE("Parsing always", "[parser][ltlf]") {
   auto actual_formula = driver.result;
   REQUIRE(expected_formula == actual_formula);
 }
+TEST_CASE("Parsing n-ary and/or", "[parser][ltlf]") {
+  auto context = std::make_shared<logic::Context>();
+  auto driver = ltlf::LTLfDriver(context);
+  auto a = context->make_atom("a");
+  auto b = context->make_atom("b");
+  auto c = context->make_atom("c");
+  auto d = context->make_atom("d");
+
+  std::istringstream conjunction("a & b & c & d");
+  driver.parse(conjunction);
+  REQUIRE(driver.result == context->make_and(logic::vec_ptr{a, b, c, d}));
+
+  std::istringstream disjunction("a | b & c | d");
+  driver.parse(disjunction);
+  auto b_and_c = context->make_and(logic::vec_ptr{b, c});
+  REQUIRE(driver.result == context->make_or(logic::vec_ptr{a, b_and_c, d}));
+
+  std::istringstream parenthesized("(a & b) & c & (d)");
+  driver.parse(parenthesized);
+  REQUIRE(driver.result == context->make_and(logic::vec_ptr{a, b, c, d}));
+
+  std::istringstream mixed("a & b -> c & d | a");
+  driver.parse(mixed);
+  auto a_and_b = context->make_and(logic::vec_ptr{a, b});
+  auto c_and_d = context->make_and(logic::vec_ptr{c, d});
+  auto c_and_d_or_a = context->make_or(logic::vec_ptr{c_and_d, a});
+  REQUIRE(driver.result ==
+          context->make_implies(logic::vec_ptr{a_and_b, c_and_d_or_a}));
+}
 } // namespace Test
 } // namespace parser
 } // namespace cynthia
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <cynthia/logic/ltlf.hpp>
+#include <cynthia/parser/string_parser.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cynthia {
+namespace parser {
+namespace Test {
+
+TEST_CASE("String parser leaves", "[parser][string_parser]") {
+  auto context = logic::Context();
+  REQUIRE(ltlf::parse_formula(context, "tt") == context.make_tt());
+  REQUIRE(ltlf::parse_formula(context, "ff") == context.make_ff());
+  REQUIRE(ltlf::parse_formula(context, "true") == context.make_prop_true());
+  REQUIRE(ltlf::parse_formula(context, "false") ==
+          context.make_prop_false());
+  REQUIRE(ltlf::parse_formula(context, "last") == context.make_last());
+  REQUIRE(ltlf::parse_formula(context, "end") == context.make_end());
+  REQUIRE(ltlf::parse_formula(context, " a_1 ") == context.make_atom("a_1"));
+  REQUIRE(ltlf::parse_formula(context, "ttx") == context.make_atom("ttx"));
+}
+
+TEST_CASE("String parser operators", "[parser][string_parser]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto parse = [&context](const std::string& text) {
+    return ltlf::parse_formula(context, text);
+  };
+
+  REQUIRE(parse("!a") == context.make_prop_not(a));
+  REQUIRE(parse("~(a & b)") ==
+          context.make_not(context.make_and(logic::vec_ptr{a, b})));
+  REQUIRE(parse("X[!] a") == context.make_next(a));
+  REQUIRE(parse("X a") == context.make_weak_next(a));
+  REQUIRE(parse("F G a") == context.make_eventually(context.make_always(a)));
+  REQUIRE(parse("a && b & c") == context.make_and(logic::vec_ptr{a, b, c}));
+  REQUIRE(parse("a || b | c") == context.make_or(logic::vec_ptr{a, b, c}));
+  REQUIRE(parse("a <-> b") == context.make_equivalent(logic::vec_ptr{a, b}));
+  REQUIRE(parse("a <=> b") == context.make_equivalent(logic::vec_ptr{a, b}));
+  REQUIRE(parse("a => b") == context.make_implies(logic::vec_ptr{a, b}));
+  REQUIRE(parse("a ^ b") == context.make_xor(logic::vec_ptr{a, b}));
+  REQUIRE(parse("a U b") == context.make_until(logic::vec_ptr{a, b}));
+  REQUIRE(parse("a V b") == context.make_release(logic::vec_ptr{a, b}));
+}
+
+TEST_CASE("String parser precedence", "[parser][string_parser]") {
+  auto context = logic::Context();
+  auto a = context.make_atom("a");
+  auto b = context.make_atom("b");
+  auto c = context.make_atom("c");
+  auto d = context.make_atom("d");
+  auto parse = [&context](const std::string& text) {
+    return ltlf::parse_formula(context, text);
+  };
+  auto a_and_b = context.make_and(logic::vec_ptr{a, b});
+  auto c_and_d = context.make_and(logic::vec_ptr{c, d});
+
+  REQUIRE(parse("a & b | c & d") ==
+          context.make_or(logic::vec_ptr{a_and_b, c_and_d}));
+  REQUIRE(parse("(a & b) & (c & d)") ==
+          context.make_and(logic::vec_ptr{a, b, c, d}));
+  // until and release are left associative, release binds tighter
+  REQUIRE(parse("a U b U c") ==
+          context.make_until(logic::vec_ptr{
+              context.make_until(logic::vec_ptr{a, b}), c}));
+  REQUIRE(parse("a U b R c") ==
+          context.make_until(logic::vec_ptr{
+              a, context.make_release(logic::vec_ptr{b, c})}));
+  // implication, equivalence and xor are right associative
+  REQUIRE(parse("a -> b -> c") ==
+          context.make_implies(logic::vec_ptr{
+              a, context.make_implies(logic::vec_ptr{b, c})}));
+  REQUIRE(parse("a ^ b ^ c") ==
+          context.make_xor(
+              logic::vec_ptr{a, context.make_xor(logic::vec_ptr{b, c})}));
+  REQUIRE(parse("a & b -> c & d <-> a") ==
+          context.make_equivalent(logic::vec_ptr{
+              context.make_implies(logic::vec_ptr{a_and_b, c_and_d}), a}));
+  // prefix operators bind tighter than infix ones
+  REQUIRE(parse("F a U b") ==
+          context.make_until(logic::vec_ptr{context.make_eventually(a), b}));
+  REQUIRE(parse("! a & X[!] b") ==
+          context.make_and(logic::vec_ptr{context.make_prop_not(a),
+                                          context.make_next(b)}));
+}
+
+TEST_CASE("String parser errors", "[parser][string_parser]") {
+  auto context = logic::Context();
+  auto parse = [&context](const std::string& text) {
+    return ltlf::parse_formula(context, text);
+  };
+  REQUIRE_THROWS_AS(parse(""), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("a &"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("(a"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("a)"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("a b"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("a & A"), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse("a < b"), std::invalid_argument);
+  REQUIRE_THROWS_WITH(parse("a &\n  | b"),
+                      "syntax error at line 2, column 3: expected a formula");
+}
+
+TEST_CASE("String parser on deep formulas", "[parser][string_parser]") {
+  auto context = logic::Context();
+  const size_t depth = 100000;
+  auto nested = std::string(depth, '(') + "a" + std::string(depth, ')');
+  REQUIRE(ltlf::parse_formula(context, nested) == context.make_atom("a"));
+
+  std::string nexts;
+  for (size_t i = 0; i < depth; ++i) {
+    nexts += "X ";
+  }
+  auto formula = ltlf::parse_formula(context, nexts + "a");
+  REQUIRE(formula->temporal_depth() == depth);
+}
+
+TEST_CASE("String parser from several threads", "[parser][string_parser]") {
+  auto context = logic::Context();
+  std::string text = "G(req_0 -> F grant_0)";
+  for (size_t i = 1; i < 50; ++i) {
+    auto n = std::to_string(i);
+    text += " & G(req_" + n + " -> F grant_" + n + ")";
+  }
+  std::vector<logic::ltlf_ptr> results(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < results.size(); ++t) {
+    threads.emplace_back([&context, &text, &results, t]() {
+      for (size_t i = 0; i < 20; ++i) {
+        results[t] = ltlf::parse_formula(context, text);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& result : results) {
+    REQUIRE(result == results[0]);
+  }
+  REQUIRE(results[0] == ltlf::parse_formula(context, text));
+}
+
+} // namespace Test
+} // namespace parser
+} // namespace cynthia
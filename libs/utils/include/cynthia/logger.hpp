@@ -85,6 +85,11 @@ public:
     error("{}", arg1);
   }
 
+  bool should_log(const LogLevel level) const {
+    return internal_logger_->should_log(
+        static_cast<spdlog::level::level_enum>(level));
+  }
+
   static void level(const LogLevel level) noexcept {
     spdlog::set_level(static_cast<spdlog::level::level_enum>(level));
   }
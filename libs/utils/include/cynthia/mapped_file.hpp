@@ -0,0 +1,49 @@
+#pragma once
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cynthia {
+namespace utils {
+
+/*
+ * Read-only memory mapping of a whole file, released on destruction.
+ */
+class MappedFile {
+private:
+  void* data_;
+  size_t size_ = 0;
+
+public:
+  /**
+   * @throw std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return static_cast<const char*>(data_); }
+  size_t size() const { return size_; }
+  std::string_view view() const { return {data(), size_}; }
+};
+
+} // namespace utils
+} // namespace cynthia
@@ -49,14 +49,15 @@ struct Deref {
     template <typename T>
     size_t operator()(std::shared_ptr<const T> const& a,
                       std::shared_ptr<const T> const& b) const {
-      return *a == *b;
+      // same node: avoid a deep comparison of shared subterms
+      return a == b or *a == *b;
     }
   };
   struct Less {
     template <typename T>
     size_t operator()(std::shared_ptr<const T> const& a,
                       std::shared_ptr<const T> const& b) const {
-      return *a < *b;
+      return a != b and *a < *b;
     }
   };
 };
@@ -143,7 +144,8 @@ from_index_map_to_vector(const std::map<T, size_t, C>& from_element_to_id) {
 }
 
 template <typename T, typename Comparator>
-int binary_search_find_index(std::vector<T> v, T data, Comparator compare) {
+int binary_search_find_index(const std::vector<T>& v, const T& data,
+                             Comparator compare) {
   auto it = std::lower_bound(v.begin(), v.end(), data, compare);
   if (it == v.end() || *it != data) {
     return -1;
@@ -160,6 +162,14 @@ template <typename T> typename std::vector<T> sort(std::vector<T> vec) {
   return vec;
 }
 
+template <typename T, typename Compare>
+typename std::vector<T> sort(std::vector<T> vec, Compare compare) {
+  if (!std::is_sorted(vec.begin(), vec.end(), compare)) {
+    std::sort(vec.begin(), vec.end(), compare);
+  }
+  return vec;
+}
+
 template <class T> inline int ordered_compare(const T& A, const T& B) {
   // Can't be equal if # of entries differ:
   if (A.size() != B.size())
@@ -0,0 +1,56 @@
+/*
+ * This file is part of Cynthia.
+ *
+ * Cynthia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cynthia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cynthia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cynthia/mapped_file.hpp>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cynthia {
+namespace utils {
+
+// mmap cannot map zero bytes, so empty files get a null mapping
+MappedFile::MappedFile(const std::string& filename) : data_{nullptr} {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open " + filename);
+  }
+  struct stat info;
+  bool ok = fstat(fd, &info) == 0;
+  if (ok and info.st_size > 0) {
+    size_ = static_cast<size_t>(info.st_size);
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ok = data_ != MAP_FAILED;
+  }
+  close(fd);
+  if (!ok) {
+    data_ = nullptr;
+    size_ = 0;
+    throw std::runtime_error("cannot map " + filename);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+} // namespace utils
+} // namespace cynthia